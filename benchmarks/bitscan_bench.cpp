@@ -0,0 +1,105 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "../src/bitScan.h"
+#include "../src/fixAlloc.h"
+
+#define FULL 0xFFFFFFFFFFFFFFFFULL
+#define RUN_LEN 16
+
+static const BitScanKernel kAllKernels[] = {
+    BitScanKernel::Scalar, BitScanKernel::Sse42, BitScanKernel::Avx2, BitScanKernel::Avx512
+};
+
+static double nsPer(std::chrono::steady_clock::time_point start, size_t reps) {
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+           / static_cast<double>(reps);
+}
+
+// Worst case for the raw kernels: every word full except the last one.
+static void runKernels(size_t numWords, size_t reps) {
+    std::vector<uint64_t> words(numWords, FULL);
+    words.back() = FULL >> RUN_LEN;
+
+    std::cout << "-- " << numWords * 64 << " bits --\n";
+    for (BitScanKernel k : kAllKernels) {
+        if (!setBitScanKernel(k)) continue;
+
+        volatile size_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < reps; ++r) sink = sink + findNonFullWord(words.data(), numWords);
+        double nonFull = nsPer(start, reps);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < reps; ++r) sink = sink + findFreeRun(words.data(), numWords, RUN_LEN);
+        double run = nsPer(start, reps);
+
+        std::cout << std::left << std::setw(8) << bitScanKernelName(k)
+                  << std::fixed << std::setprecision(2)
+                  << " first-non-full ns=" << nonFull
+                  << " first-run-of-" << RUN_LEN << " ns=" << run << "\n";
+    }
+}
+
+// Heap::claimFirstFreeIdx at 90% occupancy on a 1M-block bitmap: every
+// churn op frees a random block and claims the lowest free one.
+static void runHeapChurn(size_t ops) {
+    using Allocator = BasicFixedAllocator<Heap<LowestIndexPolicy, 1 << 20>>;
+
+    std::cout << "-- Heap<LowestIndexPolicy, 1M> churn at 90% occupancy --\n";
+    for (BitScanKernel k : kAllKernels) {
+        if (!setBitScanKernel(k)) continue;
+
+        auto allocator = std::make_unique<Allocator>();
+        std::vector<MemRange> held(Allocator::kNumBlocks * 9 / 10);
+        for (auto& r : held) r = allocator->my_malloc();
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<size_t> pick(0, held.size() - 1);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ops; ++i) {
+            MemRange& slot = held[pick(rng)];
+            allocator->my_free(slot);
+            slot = allocator->my_malloc();
+        }
+        std::cout << std::left << std::setw(8) << bitScanKernelName(k)
+                  << std::fixed << std::setprecision(2)
+                  << " ns/op=" << nsPer(start, ops) << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t reps = 2000;
+    size_t ops = 20000;
+
+    try {
+        if (argc > 1) reps = std::stoul(argv[1]);
+        if (argc > 2) ops = std::stoul(argv[2]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [scan_reps] [heap_ops]\n";
+        return 1;
+    }
+    if (reps == 0 || ops == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    BitScanKernel best = activeBitScanKernel();
+    std::cout << "Dispatch picks: " << bitScanKernelName(best) << "\n\n";
+
+    runKernels(64, reps);
+    runKernels(1024, reps);
+    runKernels(16384, reps);
+    std::cout << "\n";
+    runHeapChurn(ops);
+
+    setBitScanKernel(best);
+    return 0;
+}
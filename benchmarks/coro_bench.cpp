@@ -0,0 +1,72 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "../src/msgQueueAsync.h"
+
+#define MSG_PATTERN 0xAB
+
+// Spreads producer and consumer coroutines over one Scheduler per thread.
+// Consumers split the total message count so every task runs to completion.
+int main(int argc, char* argv[]) {
+    size_t threads = 2, producers = 1000, consumers = 1000, messages = 100;
+
+    try {
+        if (argc > 1) threads   = std::stoul(argv[1]);
+        if (argc > 2) producers = std::stoul(argv[2]);
+        if (argc > 3) consumers = std::stoul(argv[3]);
+        if (argc > 4) messages  = std::stoul(argv[4]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [threads] [producer_tasks] [consumer_tasks] [msgs_per_producer]\n";
+        return 1;
+    }
+    if (threads == 0 || producers == 0 || consumers == 0 || messages == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    std::cout << "Running " << producers << " producer and " << consumers
+              << " consumer coroutines on " << threads << " threads, "
+              << messages << " messages per producer.\n\n";
+
+    AsyncMessageQueue<> queue;
+    std::vector<Scheduler> schedulers(threads);
+
+    auto produce = [&queue](size_t count) -> Task {
+        uint8_t buffer[BLOCK_SIZE];
+        memset(buffer, MSG_PATTERN, BLOCK_SIZE);
+        for (size_t i = 0; i < count; ++i) co_await queue.async_enqueue(buffer);
+    };
+    auto consume = [&queue](size_t count) -> Task {
+        uint8_t out[BLOCK_SIZE];
+        for (size_t i = 0; i < count; ++i) co_await queue.async_dequeue(out);
+    };
+
+    size_t total = producers * messages;
+    for (size_t p = 0; p < producers; ++p) {
+        schedulers[p % threads].spawn(produce(messages));
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        size_t share = total / consumers + (c < total % consumers ? 1 : 0);
+        schedulers[c % threads].spawn(consume(share));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (auto& s : schedulers) workers.emplace_back([&s]() { s.run(); });
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    std::cout << "Messages: " << total
+              << "\nFinal Q size: " << queue.size()
+              << "\nDuration: " << duration << "us"
+              << "\nThroughput: " << std::fixed << std::setprecision(0)
+              << (duration ? total * 1e6 / duration : 0.0) << " msg/s\n";
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "../src/fixAlloc.h"
+
+// Built twice: debug_overhead_bench (release layout) and
+// debug_overhead_bench_debug (FIXALLOC_DEBUG). Compare the two outputs; the
+// release binary should report BLOCK_STRIDE == BLOCK_SIZE and the same
+// allocator size as before debug mode existed.
+
+#ifdef FIXALLOC_DEBUG
+#define BUILD_LABEL "FIXALLOC_DEBUG"
+#else
+#define BUILD_LABEL "release"
+#endif
+
+template <typename AllocatorType>
+void runChurn(const std::string& name, size_t ops) {
+    AllocatorType allocator;
+    MemRange held[8];
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        MemRange& slot = held[i % 8];
+        if (slot.lo) allocator.my_free(slot);
+        slot = allocator.my_malloc();
+        slot.lo[0] = static_cast<uint8_t>(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    for (auto& r : held) allocator.my_free(r);
+
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << std::left << std::setw(22) << name
+              << " sizeof=" << sizeof(AllocatorType)
+              << " ns/op=" << std::fixed << std::setprecision(2) << ns / ops << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = 1000000;
+
+    try {
+        if (argc > 1) ops = std::stoul(argv[1]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [ops]\n";
+        return 1;
+    }
+    if (ops == 0) {
+        std::cerr << "Error: ops must be a positive integer.\n";
+        return 1;
+    }
+
+    std::cout << "[" << BUILD_LABEL << "] BLOCK_SIZE=" << BLOCK_SIZE
+              << " BLOCK_STRIDE=" << BLOCK_STRIDE << "\n";
+    runChurn<FixedAllocator>("FixedAllocator", ops);
+    runChurn<StackFixedAllocator>("StackFixedAllocator", ops);
+    return 0;
+}
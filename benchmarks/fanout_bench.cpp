@@ -0,0 +1,80 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "../src/msgQueueFixAlloc.h"
+#include "../src/msgQueueBroadcast.h"
+
+#define MSG_PATTERN 0xAB
+
+// Fan-out via one MessageQueueFixAlloc per subscriber: N enqueues and N
+// 64-byte copies into the pools per message.
+static double runPerSubscriberQueues(size_t subscribers, size_t messages) {
+    std::vector<std::unique_ptr<MessageQueueFixAlloc>> queues;
+    for (size_t s = 0; s < subscribers; ++s) {
+        queues.push_back(std::make_unique<MessageQueueFixAlloc>());
+    }
+    uint8_t msg[BLOCK_SIZE];
+    uint8_t out[BLOCK_SIZE];
+    memset(msg, MSG_PATTERN, BLOCK_SIZE);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        for (auto& q : queues) q->enqueue(msg);
+        for (auto& q : queues) q->dequeue(out);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// Fan-out via the broadcast queue: one publish, subscribers read the shared
+// block in place.
+static double runBroadcast(size_t subscribers, size_t messages) {
+    BroadcastQueueFixAlloc<> q(subscribers);
+    uint8_t msg[BLOCK_SIZE];
+    memset(msg, MSG_PATTERN, BLOCK_SIZE);
+    volatile uint8_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        q.publish(msg);
+        for (size_t s = 0; s < subscribers; ++s) {
+            MemRange r = q.acquire(s);
+            if (!r.lo) continue;
+            sink = sink + r.lo[0];
+            q.release(r);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t messages = 100000;
+
+    try {
+        if (argc > 1) messages = std::stoul(argv[1]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [messages]\n";
+        return 1;
+    }
+    if (messages == 0) {
+        std::cerr << "Error: messages must be a positive integer.\n";
+        return 1;
+    }
+
+    std::cout << "Publishing " << messages << " messages.\n\n";
+    for (size_t subscribers : {1, 4, 16}) {
+        double perQueue = runPerSubscriberQueues(subscribers, messages);
+        double broadcast = runBroadcast(subscribers, messages);
+        std::cout << "subscribers=" << std::setw(3) << subscribers
+                  << std::fixed << std::setprecision(2)
+                  << "  per-subscriber queues ns/msg=" << perQueue / messages
+                  << "  broadcast ns/msg=" << broadcast / messages << "\n";
+    }
+    return 0;
+}
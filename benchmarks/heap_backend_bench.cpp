@@ -0,0 +1,113 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <memory>
+#include <string>
+
+#include "../src/fixAlloc.h"
+
+#define OCCUPANCY_PCT 90
+
+// Fills the pool to OCCUPANCY_PCT and then churns: each op frees a random
+// live block and allocates a replacement. With the lowest-index bitmap the
+// free bits drift towards the end of the pool, which is the multi-word
+// scan case; the stack backend pops its head regardless of pool size.
+template <typename AllocatorType>
+void runSteadyState(const std::string& name, size_t ops) {
+    auto allocator = std::make_unique<AllocatorType>();
+    size_t live = AllocatorType::kNumBlocks * OCCUPANCY_PCT / 100;
+
+    std::vector<MemRange> held(live);
+    for (auto& r : held) r = allocator->my_malloc();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, live - 1);
+    size_t failed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        MemRange& slot = held[pick(rng)];
+        allocator->my_free(slot);
+        slot = allocator->my_malloc();
+        if (!slot.lo) ++failed;
+        else slot.lo[0] = static_cast<uint8_t>(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << std::left << std::setw(26) << name
+              << " steady-state ns/op=" << std::fixed << std::setprecision(2) << ns / ops
+              << " failed_allocs=" << failed << "\n";
+}
+
+// numThreads threads each keep a small window of blocks and recycle them.
+template <typename AllocatorType>
+void runContended(const std::string& name, size_t numThreads, size_t ops) {
+    auto allocator = std::make_unique<AllocatorType>();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&]() {
+            MemRange held[4];
+            for (size_t i = 0; i < ops; ++i) {
+                MemRange& slot = held[i % 4];
+                if (slot.lo) allocator->my_free(slot);
+                slot = allocator->my_malloc();
+            }
+            for (auto& r : held) {
+                if (r.lo) allocator->my_free(r);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << std::left << std::setw(26) << name
+              << " contended ns/op=" << std::fixed << std::setprecision(2)
+              << ns / (ops * numThreads)
+              << " cas_retries=" << allocator->casRetries() << "\n";
+}
+
+template <size_t NumBlocks>
+void runSize(size_t threads, size_t ops) {
+    using Bitmap = BasicFixedAllocator<Heap<LowestIndexPolicy, NumBlocks>>;
+    using Stack = BasicFixedAllocator<StackHeap<NumBlocks>>;
+
+    std::cout << "-- " << NumBlocks << " blocks --\n";
+    runSteadyState<Bitmap>("bitmap", ops);
+    runSteadyState<Stack>("treiber-stack", ops);
+    runContended<Bitmap>("bitmap", threads, ops);
+    runContended<Stack>("treiber-stack", threads, ops);
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t threads = std::thread::hardware_concurrency();
+    size_t ops = 100000;
+
+    try {
+        if (argc > 1) threads = std::stoul(argv[1]);
+        if (argc > 2) ops = std::stoul(argv[2]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [num_threads] [ops_per_thread]\n";
+        return 1;
+    }
+    if (threads == 0 || ops == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    std::cout << "Running with " << threads << " threads, "
+              << ops << " ops per thread.\n\n";
+
+    runSize<64>(threads, ops);
+    runSize<4096>(threads, ops);
+    runSize<1 << 20>(threads, ops);
+    return 0;
+}
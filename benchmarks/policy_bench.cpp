@@ -0,0 +1,143 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <atomic>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../src/fixAlloc.h"
+
+#define HELD_BLOCKS 4
+
+// Counts hardware cache misses for this process and every thread it spawns
+// afterwards. Falls back to "n/a" where perf events are unavailable.
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    // Stops the counter; returns -1 if it could not be opened.
+    long long stop() {
+#ifdef __linux__
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd_, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// Each thread keeps a small window of live blocks, writes every block it
+// gets and frees the oldest, so allocation and release interleave across
+// threads the way a producer/consumer pool does.
+template <typename SelectPolicy>
+void runPolicy(const std::string& name, size_t numThreads, size_t ticks) {
+    BasicFixedAllocator<Heap<SelectPolicy>> allocator;
+    std::atomic<size_t> failedAllocs{0};
+
+    CacheMissCounter misses;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            MemRange held[HELD_BLOCKS];
+            size_t next = 0;
+            size_t failed = 0;
+            for (size_t i = 0; i < ticks; ++i) {
+                MemRange& slot = held[next];
+                if (slot.lo) allocator.my_free(slot);
+                slot = allocator.my_malloc();
+                if (slot.lo) memset(slot.lo, static_cast<int>(t), BLOCK_SIZE);
+                else ++failed;
+                next = (next + 1) % HELD_BLOCKS;
+            }
+            for (auto& r : held) {
+                if (r.lo) allocator.my_free(r);
+            }
+            failedAllocs.fetch_add(failed);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto end = std::chrono::steady_clock::now();
+    long long cacheMisses = misses.stop();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    size_t failed = failedAllocs.load();
+    size_t ops = numThreads * ticks;
+
+    std::cout << std::left << std::setw(14) << name
+              << " duration=" << duration << "us"
+              << " cas_retries=" << allocator.casRetries()
+              << " retries/op=" << std::fixed << std::setprecision(4)
+              << static_cast<double>(allocator.casRetries()) / ops
+              << " failed_allocs=" << failed
+              << " cache_misses=";
+    if (cacheMisses < 0) std::cout << "n/a";
+    else std::cout << cacheMisses;
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t threads = std::thread::hardware_concurrency();
+    size_t ticks = 200000;
+
+    try {
+        if (argc > 1) threads = std::stoul(argv[1]);
+        if (argc > 2) ticks = std::stoul(argv[2]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [num_threads] [ticks_per_thread]\n";
+        return 1;
+    }
+    if (threads == 0 || ticks == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    std::cout << "Running with " << threads << " threads, "
+              << ticks << " ticks per thread.\n\n";
+
+    runPolicy<LowestIndexPolicy>("lowest-index", threads, ticks);
+    runPolicy<LifoPolicy>("lifo", threads, ticks);
+    runPolicy<RoundRobinPolicy>("round-robin", threads, ticks);
+    runPolicy<RandomPolicy>("random", threads, ticks);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <memory>
+#include <atomic>
+
+#include "../src/msgQueuePriority.h"
+#include "../src/metrics.h"
+
+#define MSG_PATTERN 0xAB
+#define CONTROL_LANE 0
+#define BULK_LANE 1
+#define CONTROL_EVERY 16
+
+using LaneQueue = PriorityMessageQueueFixAlloc<2>;
+
+// Producers send one control message per CONTROL_EVERY bulk messages and
+// take the simulator's idle gap every 64 iterations; consumers drain until
+// the producers are done and record how long each message sat in its lane.
+// Run once with no quota and once with bulk capped so control always finds
+// a block.
+static void runLanes(const std::string& name, size_t producers, size_t consumers,
+                     size_t ticks, size_t bulkQuota) {
+    auto queue = std::make_unique<LaneQueue>();
+    if (bulkQuota) queue->setLaneQuota(BULK_LANE, bulkQuota);
+
+    Metrics global_metrics;
+    std::vector<ThreadMetrics> thread_metrics(producers + consumers);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> producersLeft{producers};
+
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            ThreadMetrics& tm = thread_metrics[p];
+            std::mt19937 rng(p + 1);
+            std::uniform_int_distribution<int> idleDist(50, 200);
+            uint8_t buffer[BLOCK_SIZE];
+            memset(buffer, MSG_PATTERN, BLOCK_SIZE);
+            for (size_t i = 0; i < ticks; ++i) {
+                size_t lane = i % CONTROL_EVERY == 0 ? CONTROL_LANE : BULK_LANE;
+                auto t0 = std::chrono::steady_clock::now();
+                bool ok = queue->enqueue(lane, buffer);
+                auto t1 = std::chrono::steady_clock::now();
+                tm.record_enqueue(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(), ok);
+                if (i % 64 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(idleDist(rng)));
+                }
+            }
+            producersLeft.fetch_sub(1);
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            ThreadMetrics& tm = thread_metrics[producers + c];
+            std::mt19937 rng(c + 101);
+            std::uniform_int_distribution<int> holdDist(100, 500);
+            uint8_t out[BLOCK_SIZE];
+            while (producersLeft.load() > 0 || queue->size() > 0) {
+                size_t lane = 0;
+                long queued = 0;
+                auto t0 = std::chrono::steady_clock::now();
+                bool ok = queue->dequeue(out, &lane, &queued);
+                auto t1 = std::chrono::steady_clock::now();
+                tm.record_dequeue(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(), ok);
+                if (ok) {
+                    tm.record_lane(lane, queued);
+                    for (volatile int h = holdDist(rng); h > 0; --h) {
+                        // spin to simulate processing
+                    }
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (auto& tm : thread_metrics) global_metrics.merge(tm);
+
+    std::cout << "[" << name << "]\n";
+    global_metrics.summarize(std::cout);
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t producers = 2, consumers = 1, ticks = 30000;
+
+    try {
+        if (argc > 1) producers = std::stoul(argv[1]);
+        if (argc > 2) consumers = std::stoul(argv[2]);
+        if (argc > 3) ticks     = std::stoul(argv[3]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [num_producers] [num_consumers] [ticks_per_thread]\n";
+        return 1;
+    }
+    if (producers == 0 || consumers == 0 || ticks == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    std::cout << "Lane " << CONTROL_LANE << " = control, lane " << BULK_LANE << " = bulk.\n\n";
+    runLanes("No quota", producers, consumers, ticks, 0);
+    runLanes("Bulk quota " + std::to_string(NUM_BLOCKS * 3 / 4),
+             producers, consumers, ticks, NUM_BLOCKS * 3 / 4);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <atomic>
+#include <memory>
+
+#include "../src/msgQueueFixAlloc.h"
+#include "../src/shardedQueue.h"
+
+#define MSG_PATTERN 0xAB
+#define SHARDS 8
+
+using ShardedFixAlloc = ShardedQueueGroup<MessageQueueFixAlloc, SHARDS>;
+
+// `pairs` producers each push `messages` (retrying when full) while `pairs`
+// consumers drain until everything has been received. No idle gaps: this
+// measures the queue ceiling, not the workload.
+template <typename QueueType>
+double runPairs(QueueType& queue, size_t pairs, size_t messages) {
+    std::atomic<size_t> received{0};
+    size_t total = pairs * messages;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < pairs; ++p) {
+        threads.emplace_back([&]() {
+            uint8_t buffer[BLOCK_SIZE];
+            memset(buffer, MSG_PATTERN, BLOCK_SIZE);
+            for (size_t i = 0; i < messages; ++i) {
+                while (!queue.enqueue(buffer)) std::this_thread::yield();
+            }
+        });
+    }
+    for (size_t c = 0; c < pairs; ++c) {
+        threads.emplace_back([&]() {
+            uint8_t out[BLOCK_SIZE];
+            while (received.load(std::memory_order_relaxed) < total) {
+                if (queue.dequeue(out)) received.fetch_add(1, std::memory_order_relaxed);
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    double secs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1e6;
+    return total / secs;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxPairs = 8;
+    size_t messages = 100000;
+
+    try {
+        if (argc > 1) maxPairs = std::stoul(argv[1]);
+        if (argc > 2) messages = std::stoul(argv[2]);
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [max_pairs] [msgs_per_producer]\n";
+        return 1;
+    }
+    if (maxPairs == 0 || messages == 0) {
+        std::cerr << "Error: All arguments must be positive integers.\n";
+        return 1;
+    }
+
+    std::cout << "Shared queue vs " << SHARDS << "-shard group, "
+              << messages << " messages per producer.\n\n";
+
+    for (size_t pairs = 1; pairs <= maxPairs; pairs *= 2) {
+        auto shared = std::make_unique<MessageQueueFixAlloc>();
+        auto sharded = std::make_unique<ShardedFixAlloc>();
+
+        double sharedRate = runPairs(*shared, pairs, messages);
+        double shardedRate = runPairs(*sharded, pairs, messages);
+
+        std::cout << pairs << "P/" << pairs << "C"
+                  << std::fixed << std::setprecision(0)
+                  << "  shared msg/s=" << sharedRate
+                  << "  sharded msg/s=" << shardedRate
+                  << "  steals=[";
+        for (size_t s = 0; s < SHARDS; ++s) {
+            std::cout << (s ? " " : "") << sharded->steals(s);
+        }
+        std::cout << "]\n";
+    }
+    return 0;
+}
@@ -1,4 +1,18 @@
 #include "sim_runner_utils.h"
+#include <iomanip>
+#include <functional>
+#include <memory>
+
+// Pool-occupancy probe for queues that expose one; MessageQueueStd has no pool.
+template <typename QueueType>
+static auto pool_probe(QueueType& queue, int) -> decltype(queue.poolInUse(), std::function<size_t()>()) {
+    return [&queue]() { return queue.poolInUse(); };
+}
+
+template <typename QueueType>
+static std::function<size_t()> pool_probe(QueueType&, long) {
+    return {};
+}
 
 template <typename QueueType>
 void SimRunnerMT<QueueType>::run(const std::string& name) {
@@ -9,6 +23,20 @@ void SimRunnerMT<QueueType>::run(const std::string& name) {
 
     std::vector<ThreadMetrics> thread_metrics(num_producers + num_consumers);
     std::vector<std::thread> threads;
+
+    std::cout << "[" << name << "]\n";
+
+    std::unique_ptr<LiveReporter> reporter;
+    if (report_interval_ms > 0) {
+        reporter = std::make_unique<LiveReporter>(thread_metrics.size(),
+                                                  std::chrono::milliseconds(report_interval_ms),
+                                                  std::cout);
+        reporter->setPoolProbe(pool_probe(queue, 0));
+        for (size_t t = 0; t < thread_metrics.size(); ++t) {
+            thread_metrics[t].live = &reporter->counters(t);
+        }
+        reporter->start();
+    }
     threads.reserve(num_producers + num_consumers);
 
     for (size_t p = 0; p < num_producers; ++p) {
@@ -25,6 +53,7 @@ void SimRunnerMT<QueueType>::run(const std::string& name) {
     for (auto& t : threads) {
         t.join();
     }
+    if (reporter) reporter->stop();
 
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -33,26 +62,30 @@ void SimRunnerMT<QueueType>::run(const std::string& name) {
         global_metrics.merge(tm);
     }
 
-    std::cout << "[" << name << "]\n";
     global_metrics.summarize(std::cout);
-    std::cout << "Duration: " << duration << "us\n\n";
+    std::cout << "Duration: " << duration << "us\n";
+    std::cout << "Throughput: " << std::fixed << std::setprecision(0)
+              << (duration ? global_metrics.received() * 1e6 / duration : 0.0)
+              << " msg/s\n\n";
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 4) {
-        std::cerr << "Usage: " << argv[0] << " <num_producers> <num_consumers> <ticks_per_thread>\n"
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <num_producers> <num_consumers> <ticks_per_thread> [report_interval_ms]\n"
                   << "  <num_producers>   Number of producer threads (positive integer)\n"
                   << "  <num_consumers>   Number of consumer threads (positive integer)\n"
-                  << "  <ticks_per_thread> Number of iterations per thread (positive integer)\n";
+                  << "  <ticks_per_thread> Number of iterations per thread (positive integer)\n"
+                  << "  [report_interval_ms] Print a live stats row at this interval (optional)\n";
         return 1;
     }
 
-    size_t producers, consumers, ticks;
+    size_t producers, consumers, ticks, report_ms = 0;
 
     try {
         producers = std::stoul(argv[1]);
         consumers = std::stoul(argv[2]);
         ticks     = std::stoul(argv[3]);
+        if (argc == 5) report_ms = std::stoul(argv[4]);
     } catch (const std::invalid_argument&) {
         std::cerr << "Error: All arguments must be integers.\n";
         return 1;
@@ -71,10 +104,16 @@ int main(int argc, char* argv[]) {
               << consumers << " consumers, "
               << ticks << " ticks per thread.\n\n";
 
-    SimRunnerMT<MessageQueueFixAlloc> sim_fix(producers, consumers, ticks);
+    SimRunnerMT<MessageQueueFixAlloc> sim_fix(producers, consumers, ticks, report_ms);
     sim_fix.run("Fixed Allocator MT");
 
-    SimRunnerMT<MessageQueueStd> sim_std(producers, consumers, ticks);
+    SimRunnerMT<MessageQueueStackAlloc> sim_stack(producers, consumers, ticks, report_ms);
+    sim_stack.run("Fixed Allocator (Treiber stack) MT");
+
+    SimRunnerMT<ShardedQueueFixAlloc> sim_sharded(producers, consumers, ticks, report_ms);
+    sim_sharded.run("Fixed Allocator (" + std::to_string(SIM_SHARDS) + " shards) MT");
+
+    SimRunnerMT<MessageQueueStd> sim_std(producers, consumers, ticks, report_ms);
     sim_std.run("Std Allocator MT");
 
     return 0;
@@ -1,10 +1,12 @@
 #include "sim_runner_utils.h"
 
 template <typename QueueType>
-SimRunnerMT<QueueType>::SimRunnerMT(size_t producers, size_t consumers, size_t ticks)
+SimRunnerMT<QueueType>::SimRunnerMT(size_t producers, size_t consumers, size_t ticks,
+                                    size_t report_interval_ms)
     : num_producers(producers),
       num_consumers(consumers),
       total_ticks(ticks),
+      report_interval_ms(report_interval_ms),
       sent(0),
       dropped(0),
       received(0) {}
@@ -83,6 +85,8 @@ void SimRunnerMT<QueueType>::idle_gap(std::mt19937& rng) {
 
 // Explicit instantiations so linker sees the symbols
 template class SimRunnerMT<MessageQueueFixAlloc>;
+template class SimRunnerMT<MessageQueueStackAlloc>;
+template class SimRunnerMT<ShardedQueueFixAlloc>;
 template class SimRunnerMT<MessageQueueStd>;
 
 
@@ -10,14 +10,19 @@
 
 #include "../src/msgQueueFixAlloc.h"
 #include "../src/msgQueueStd.h"
+#include "../src/shardedQueue.h"
 #include "../src/metrics.h"
 
 #define MSG_PATTERN 0xAB
+#define SIM_SHARDS 4
+
+using ShardedQueueFixAlloc = ShardedQueueGroup<MessageQueueFixAlloc, SIM_SHARDS>;
 
 template <typename QueueType>
 class SimRunnerMT {
 public:
-    SimRunnerMT(size_t producers, size_t consumers, size_t ticks);
+    SimRunnerMT(size_t producers, size_t consumers, size_t ticks,
+                size_t report_interval_ms = 0);
 
     void run(const std::string& name);
 
@@ -32,6 +37,7 @@ private:
     size_t num_producers;
     size_t num_consumers;
     size_t total_ticks;
+    size_t report_interval_ms;  // 0 = no live reporting
 
     std::atomic<size_t> sent;
     std::atomic<size_t> dropped;
@@ -0,0 +1,210 @@
+/*
+    Notes:
+    >   Each vector kernel compares 512 bits per iteration against all-ones
+        and falls back to scalar for the tail. Kernels are compiled with
+        per-function target attributes so the rest of the tree keeps the
+        baseline ISA; dispatch happens once via __builtin_cpu_supports.
+    >   findNonFullWord runs on live heap metadata that other threads CAS
+        with __atomic builtins. The scalar kernel reads each word with a
+        relaxed __atomic_load_n, which is well defined. C++ has no atomic
+        vector load, so the vector kernels' plain loads are a data race by
+        the language rules. They rely on platform behaviour instead: x86
+        vector loads never fault or trap on concurrently written memory, and
+        the worst outcome is a stale or mixed set of lanes. The result is
+        only a hint and every claim is a CAS, so a wrong answer costs a
+        retry, not a double allocation. These kernels are excluded from
+        ThreadSanitizer (BITSCAN_RACY_READ) so that known race is not
+        reported on every multi-word claim.
+*/
+
+#include "bitScan.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITSCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#define ALL_ONES 0xFFFFFFFFFFFFFFFFULL
+
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define BITSCAN_RACY_READ __attribute__((no_sanitize("thread")))
+#else
+#define BITSCAN_RACY_READ
+#endif
+
+static size_t nonFullScalar(const uint64_t* words, size_t n){
+    for (size_t i = 0; i < n; ++i){
+        if (__atomic_load_n(&words[i], __ATOMIC_RELAXED) != ALL_ONES) return i;
+    }
+    return n;
+}
+
+#ifdef BITSCAN_X86
+__attribute__((target("sse4.2"))) BITSCAN_RACY_READ
+static size_t nonFullSse42(const uint64_t* words, size_t n){
+    const __m128i ones = _mm_set1_epi64x(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 2));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 4));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 6));
+        __m128i all = _mm_and_si128(_mm_and_si128(a, b), _mm_and_si128(c, d));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi64(all, ones)) != 0xFFFF){
+            return i + nonFullScalar(words + i, 8);
+        }
+    }
+    return i + nonFullScalar(words + i, n - i);
+}
+
+__attribute__((target("avx2"))) BITSCAN_RACY_READ
+static size_t nonFullAvx2(const uint64_t* words, size_t n){
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 4));
+        __m256i all = _mm256_and_si256(a, b);
+        // testc: CF=1 iff every bit of `all` is set
+        if (!_mm256_testc_si256(all, _mm256_set1_epi64x(-1))){
+            return i + nonFullScalar(words + i, 8);
+        }
+    }
+    return i + nonFullScalar(words + i, n - i);
+}
+
+__attribute__((target("avx512f"))) BITSCAN_RACY_READ
+static size_t nonFullAvx512(const uint64_t* words, size_t n){
+    const __m512i ones = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m512i v = _mm512_loadu_si512(words + i);
+        __mmask8 notFull = _mm512_cmpneq_epu64_mask(v, ones);
+        if (notFull) return i + __builtin_ctz(notFull);
+    }
+    return i + nonFullScalar(words + i, n - i);
+}
+#endif
+
+typedef size_t (*NonFullFn)(const uint64_t*, size_t);
+
+static NonFullFn kernelFn(BitScanKernel kernel){
+#ifdef BITSCAN_X86
+    switch (kernel){
+        case BitScanKernel::Avx512: return nonFullAvx512;
+        case BitScanKernel::Avx2:   return nonFullAvx2;
+        case BitScanKernel::Sse42:  return nonFullSse42;
+        case BitScanKernel::Scalar: break;
+    }
+#else
+    (void)kernel;
+#endif
+    return nonFullScalar;
+}
+
+static BitScanKernel bestKernel(){
+#ifdef BITSCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return BitScanKernel::Avx512;
+    if (__builtin_cpu_supports("avx2"))    return BitScanKernel::Avx2;
+    if (__builtin_cpu_supports("sse4.2"))  return BitScanKernel::Sse42;
+#endif
+    return BitScanKernel::Scalar;
+}
+
+static std::atomic<BitScanKernel>& activeKernel(){
+    static std::atomic<BitScanKernel> kernel{bestKernel()};
+    return kernel;
+}
+
+static std::atomic<NonFullFn>& activeFn(){
+    static std::atomic<NonFullFn> fn{kernelFn(activeKernel().load())};
+    return fn;
+}
+
+size_t findNonFullWord(const uint64_t* words, size_t n){
+    return activeFn().load(std::memory_order_relaxed)(words, n);
+}
+
+// Bit mask of positions where runLen (1..64) consecutive clear bits start
+// inside a single word.
+static uint64_t runStarts(uint64_t freeBits, size_t runLen){
+    size_t len = 1;
+    while (len < runLen){
+        size_t shift = len < runLen - len ? len : runLen - len;
+        freeBits &= freeBits >> shift;
+        len += shift;
+    }
+    return freeBits;
+}
+
+long findFreeRun(const uint64_t* words, size_t n, size_t runLen){
+    if (runLen == 0 || runLen > n * 64) return -1;
+
+    size_t run = 0;      // clear bits carried over from previous words
+    size_t i = 0;
+    while (i < n){
+        if (words[i] == ALL_ONES){
+            // A full word breaks any run; jump to the next word with room.
+            run = 0;
+            i += findNonFullWord(words + i, n - i);
+            continue;
+        }
+
+        uint64_t freeBits = ~words[i];
+        if (freeBits == ALL_ONES){
+            run += 64;
+            if (run >= runLen) return static_cast<long>((i + 1) * 64 - run);
+            ++i;
+            continue;
+        }
+
+        size_t lowFree = __builtin_ctzll(words[i]);
+        if (run + lowFree >= runLen) return static_cast<long>(i * 64 - run);
+
+        if (runLen <= 64){
+            uint64_t starts = runStarts(freeBits, runLen);
+            if (starts) return static_cast<long>(i * 64 + __builtin_ctzll(starts));
+        }
+
+        run = __builtin_clzll(words[i]);
+        ++i;
+    }
+    return -1;
+}
+
+bool bitScanKernelSupported(BitScanKernel kernel){
+#ifdef BITSCAN_X86
+    __builtin_cpu_init();
+    switch (kernel){
+        case BitScanKernel::Avx512: return __builtin_cpu_supports("avx512f");
+        case BitScanKernel::Avx2:   return __builtin_cpu_supports("avx2");
+        case BitScanKernel::Sse42:  return __builtin_cpu_supports("sse4.2");
+        case BitScanKernel::Scalar: return true;
+    }
+    return false;
+#else
+    return kernel == BitScanKernel::Scalar;
+#endif
+}
+
+bool setBitScanKernel(BitScanKernel kernel){
+    if (!bitScanKernelSupported(kernel)) return false;
+    activeKernel().store(kernel);
+    activeFn().store(kernelFn(kernel));
+    return true;
+}
+
+BitScanKernel activeBitScanKernel(){
+    return activeKernel().load();
+}
+
+const char* bitScanKernelName(BitScanKernel kernel){
+    switch (kernel){
+        case BitScanKernel::Avx512: return "avx512";
+        case BitScanKernel::Avx2:   return "avx2";
+        case BitScanKernel::Sse42:  return "sse4.2";
+        case BitScanKernel::Scalar: return "scalar";
+    }
+    return "unknown";
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Free-bit search over multi-word bitmaps (set bit = block in use).
+// Vector kernels test 512 bits per step; the best one the CPU supports is
+// picked on first use, with a scalar fallback on every platform.
+
+enum class BitScanKernel { Scalar, Sse42, Avx2, Avx512 };
+
+// Index of the first word in [0, n) with a clear bit, or n if all are full.
+// May run while other threads update the words with __atomic builtins; the
+// answer is then only a hint (see bitScan.cpp).
+size_t findNonFullWord(const uint64_t* words, size_t n);
+
+// Bit index of the first run of runLen clear bits in words[0, n), or -1.
+// Expects a bitmap nobody is modifying.
+long findFreeRun(const uint64_t* words, size_t n, size_t runLen);
+
+// Kernel selection, for benchmarks and tests. setBitScanKernel returns
+// false (and changes nothing) if the CPU lacks the instruction set.
+bool bitScanKernelSupported(BitScanKernel kernel);
+bool setBitScanKernel(BitScanKernel kernel);
+BitScanKernel activeBitScanKernel();
+const char* bitScanKernelName(BitScanKernel kernel);
@@ -1,57 +1,346 @@
 /* 
     Notes: 
-    >   
+    >   Block selection is a compile-time policy and the heap backend is a
+        template parameter (see fixAlloc.h). Definitions live here and are
+        explicitly instantiated at the bottom.
+    >   Multi-word bitmaps find the next non-full word with the vectorized
+        scan in bitScan.cpp.
+    >   FIXALLOC_DEBUG code is fenced with #ifdef so the release build is
+        byte-for-byte the same path. ASan poisoning is a no-op without ASan.
 */
 
 #include "fixAlloc.h"
+#include "bitScan.h"
 #include <iostream>
+#include <cstring>
 
-int Heap::claimFirstFreeIdx(){
-    uint64_t bitField = metadata_.load();
+#ifdef FIXALLOC_ASAN
+#include <sanitizer/asan_interface.h>
+#else
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+#include <functional>
+#include <thread>
+
+static unsigned threadSeed(){
+    size_t h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return static_cast<unsigned>(h ^ (h >> 32)) | 1u;
+}
+
+static uint64_t rotateRight(uint64_t x, unsigned r){
+    return r ? (x >> r) | (x << (64 - r)) : x;
+}
+
+namespace {
+struct LifoEntry {
+    uint32_t owner;
+    int idx;
+};
+
+// Ring of the calling thread's most recent releases; the oldest entry is
+// overwritten once LIFO_DEPTH are held.
+struct LifoStack {
+    LifoEntry entries[LIFO_DEPTH];
+    unsigned top = 0;
+    unsigned count = 0;
+};
+
+thread_local LifoStack lifoStack;
+std::atomic<uint32_t> nextLifoId{1};
+}
+
+LifoPolicy::LifoPolicy() : id_(nextLifoId.fetch_add(1, std::memory_order_relaxed)) {}
+
+// Entries left by other heaps are discarded on the way down.
+unsigned LifoPolicy::startHint(){
+    LifoStack& s = lifoStack;
+    while (s.count > 0){
+        s.top = (s.top + LIFO_DEPTH - 1) % LIFO_DEPTH;
+        --s.count;
+        if (s.entries[s.top].owner == id_) return s.entries[s.top].idx;
+    }
+    return 0;
+}
+
+void LifoPolicy::onRelease(int idx){
+    LifoStack& s = lifoStack;
+    s.entries[s.top] = {id_, idx};
+    s.top = (s.top + 1) % LIFO_DEPTH;
+    if (s.count < LIFO_DEPTH) ++s.count;
+}
+
+unsigned RoundRobinPolicy::startHint(){
+    static thread_local unsigned cursor = threadSeed();
+    return cursor++;
+}
+
+unsigned RandomPolicy::startHint(){
+    static thread_local uint32_t state = threadSeed();
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template <typename SelectPolicy, size_t NumBlocks>
+int Heap<SelectPolicy, NumBlocks>::claimFirstFreeIdx(){
+    unsigned hint = policy_.startHint() % NumBlocks;
+    size_t startWord = hint / 64;
+
+    int bit = claimInWord(startWord, hint % 64);
+    if (bit != -1) return static_cast<int>(startWord * 64) + bit;
+
+    int idx = claimInRange(startWord + 1, kNumWords);
+    if (idx != -1) return idx;
+    return claimInRange(0, startWord);
+}
+
+// findNonFullWord only picks a candidate word; the claim is a CAS on that
+// word, and a miss moves the scan on. Its scalar kernel uses relaxed atomic
+// loads, but the vector kernels read with plain loads, which is a data race
+// under the C++ memory model. That part relies on x86 behaviour, not on the
+// language; see bitScan.cpp.
+template <typename SelectPolicy, size_t NumBlocks>
+int Heap<SelectPolicy, NumBlocks>::claimInRange(size_t from, size_t to){
+    while (from < to){
+        size_t word = from + findNonFullWord(metadata_ + from, to - from);
+        if (word == to) return -1;
+        int bit = claimInWord(word, 0);
+        if (bit != -1) return static_cast<int>(word * 64) + bit;
+        from = word + 1;
+    }
+    return -1;
+}
+
+template <typename SelectPolicy, size_t NumBlocks>
+int Heap<SelectPolicy, NumBlocks>::claimInWord(size_t word, unsigned startBit){
+    uint64_t bitField = __atomic_load_n(&metadata_[word], __ATOMIC_SEQ_CST);
     if (bitField == 0xFFFFFFFFFFFFFFFFULL) return -1;
 
     while (true){
         uint64_t inverted = ~bitField;
         if (inverted == 0) return -1;
-        int bit = __builtin_ctzll(inverted);
+        int bit = (__builtin_ctzll(rotateRight(inverted, startBit)) + startBit) % 64;
         uint64_t mask = 1ULL << bit;
         uint64_t newBitField = bitField | mask;
-        if (metadata_.compare_exchange_weak(bitField, newBitField)) return bit;
+        if (__atomic_compare_exchange_n(&metadata_[word], &bitField, newBitField, true,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) return bit;
+        casRetries_.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
-int Heap::releaseIdx(int idx){
-    uint64_t bitField = metadata_.load();
-    uint64_t mask = 1ULL << idx;
+template <typename SelectPolicy, size_t NumBlocks>
+int Heap<SelectPolicy, NumBlocks>::releaseIdx(int idx){
+    uint64_t* word = &metadata_[idx / 64];
+    uint64_t bitField = __atomic_load_n(word, __ATOMIC_SEQ_CST);
+    uint64_t mask = 1ULL << (idx % 64);
 
     if ((bitField & mask) == 0) return -1;
     while(true){
         uint64_t newBitField = bitField & ~mask;
-        if (metadata_.compare_exchange_weak(bitField, newBitField)) return 0;
+        if (__atomic_compare_exchange_n(word, &bitField, newBitField, true,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)){
+            policy_.onRelease(idx);
+            return 0;
+        }
+        casRetries_.fetch_add(1, std::memory_order_relaxed);
         if ((bitField & mask) == 0) return -1;
     }
 }
 
-FixedAllocator::FixedAllocator() {}
+template <typename SelectPolicy, size_t NumBlocks>
+size_t Heap<SelectPolicy, NumBlocks>::blocksInUse() const{
+    size_t used = 0;
+    for (const uint64_t& word : metadata_){
+        used += __builtin_popcountll(__atomic_load_n(&word, __ATOMIC_RELAXED));
+    }
+    return used;
+}
+
+template <size_t NumBlocks>
+StackHeap<NumBlocks>::StackHeap(){
+    for (size_t i = 0; i < NumBlocks; ++i){
+        next_[i].store(i + 1 < NumBlocks ? static_cast<uint32_t>(i + 1) : kEmpty,
+                       std::memory_order_relaxed);
+    }
+    head_.store(NumBlocks ? 0 : kEmpty);
+}
+
+template <size_t NumBlocks>
+int StackHeap<NumBlocks>::claimFirstFreeIdx(){
+    uint64_t head = head_.load();
 
-MemRange FixedAllocator::my_malloc(){
+    while (true){
+        uint32_t idx = static_cast<uint32_t>(head);
+        if (idx == kEmpty) return -1;
+        uint64_t tag = (head >> 32) + 1;
+        uint64_t newHead = (tag << 32) | next_[idx].load(std::memory_order_relaxed);
+        if (head_.compare_exchange_weak(head, newHead)){
+            inUse_[idx].store(true, std::memory_order_relaxed);
+            return static_cast<int>(idx);
+        }
+        casRetries_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <size_t NumBlocks>
+int StackHeap<NumBlocks>::releaseIdx(int idx){
+    if (!inUse_[idx].exchange(false)) return -1;
+
+    uint64_t head = head_.load();
+    while (true){
+        next_[idx].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        uint64_t tag = (head >> 32) + 1;
+        uint64_t newHead = (tag << 32) | static_cast<uint32_t>(idx);
+        if (head_.compare_exchange_weak(head, newHead)) return 0;
+        casRetries_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <size_t NumBlocks>
+size_t StackHeap<NumBlocks>::blocksInUse() const{
+    size_t used = 0;
+    for (const auto& flag : inUse_){
+        used += flag.load(std::memory_order_relaxed);
+    }
+    return used;
+}
+
+template <typename HeapType>
+BasicFixedAllocator<HeapType>::BasicFixedAllocator(){
+#ifdef FIXALLOC_DEBUG
+    for (size_t i = 0; i < kNumBlocks; ++i){
+        uint8_t* block = &myHeap_.pool_[i * BLOCK_STRIDE];
+        memset(block, FIXALLOC_POISON, BLOCK_SIZE);
+        memset(block + BLOCK_SIZE, FIXALLOC_CANARY, FIXALLOC_GUARD_SIZE);
+    }
+#endif
+    ASAN_POISON_MEMORY_REGION(myHeap_.pool_, sizeof(myHeap_.pool_));
+}
+
+#if defined(FIXALLOC_DEBUG) || defined(FIXALLOC_ASAN)
+template <typename HeapType>
+BasicFixedAllocator<HeapType>::~BasicFixedAllocator(){
+#ifdef FIXALLOC_DEBUG
+    size_t leaked = 0;
+    for (size_t i = 0; i < kNumBlocks; ++i){
+        const BlockRecord& rec = records_[i];
+        if (!rec.file) continue;
+        ++leaked;
+        std::cerr << "[fixAlloc] leak: block " << i << " (" << BLOCK_SIZE
+                  << " bytes) allocated by thread " << rec.owner
+                  << " at " << rec.file << ":" << rec.line << "\n";
+    }
+    if (leaked){
+        std::cerr << "[fixAlloc] " << leaked << " of " << kNumBlocks
+                  << " blocks still allocated at destruction\n";
+    }
+#endif
+    // The pool's storage outlives us (stack/heap reuse); hand it back clean.
+    ASAN_UNPOISON_MEMORY_REGION(myHeap_.pool_, sizeof(myHeap_.pool_));
+}
+#endif
+
+#ifdef FIXALLOC_DEBUG
+template <typename HeapType>
+void BasicFixedAllocator<HeapType>::reportError(const char* what, int idx){
+    debugErrors_.fetch_add(1);
+    const BlockRecord& rec = records_[idx];
+    std::cerr << "[fixAlloc] " << what << ": block " << idx;
+    if (rec.file) std::cerr << " allocated at " << rec.file << ":" << rec.line;
+    std::cerr << "\n";
+}
+#endif
+
+#ifdef FIXALLOC_DEBUG
+template <typename HeapType>
+MemRange BasicFixedAllocator<HeapType>::my_malloc(const char* file, int line){
+#else
+template <typename HeapType>
+MemRange BasicFixedAllocator<HeapType>::my_malloc(){
+#endif
     int freeIdx = myHeap_.claimFirstFreeIdx();
     MemRange memBlock;
     
     if (freeIdx != -1){
-        uint8_t* startMemAddr = &(myHeap_.pool_[freeIdx * BLOCK_SIZE]);
-        uint8_t* endMemAddr = &(myHeap_.pool_[(freeIdx + 1) * BLOCK_SIZE - 1]);
+        uint8_t* startMemAddr = &(myHeap_.pool_[static_cast<size_t>(freeIdx) * BLOCK_STRIDE]);
+        ASAN_UNPOISON_MEMORY_REGION(startMemAddr, BLOCK_SIZE);
+#ifdef FIXALLOC_DEBUG
+        for (int i = 0; i < BLOCK_SIZE; ++i){
+            if (startMemAddr[i] != FIXALLOC_POISON){
+                reportError("write after free", freeIdx);
+                break;
+            }
+        }
+        memset(startMemAddr, FIXALLOC_ALLOC_FILL, BLOCK_SIZE);
+        BlockRecord& rec = records_[freeIdx];
+        rec.owner = std::this_thread::get_id();
+        rec.file = file;
+        rec.line = line;
+#endif
         memBlock.lo = startMemAddr;
-        memBlock.hi = endMemAddr;
+        memBlock.hi = startMemAddr + BLOCK_SIZE - 1;
     }
     return memBlock;
 }
 
-bool FixedAllocator::my_free(const MemRange memBlock){
-    if (!memBlock.lo || !memBlock.hi) return false;
-    if ((memBlock.lo - &myHeap_.pool_[0]) % BLOCK_SIZE) return false;
-    int idxToFree = (memBlock.lo - &myHeap_.pool_[0]) / BLOCK_SIZE;
-    if(!(idxToFree < 64 && idxToFree >= 0)) return false;
+template <typename HeapType>
+bool BasicFixedAllocator<HeapType>::my_free(const MemRange memBlock){
+    int idxToFree = blockIndex(memBlock);
+    if (idxToFree == -1) return false;
+
+#ifdef FIXALLOC_DEBUG
+    BlockRecord& rec = records_[idxToFree];
+    if (!rec.file) return myHeap_.releaseIdx(idxToFree) == 0;   // not live: let the heap reject it
+
+    uint8_t* guard = memBlock.lo + BLOCK_SIZE;
+    ASAN_UNPOISON_MEMORY_REGION(guard, FIXALLOC_GUARD_SIZE);
+    for (int i = 0; i < FIXALLOC_GUARD_SIZE; ++i){
+        if (guard[i] != FIXALLOC_CANARY){
+            reportError("canary overwritten", idxToFree);
+            memset(guard, FIXALLOC_CANARY, FIXALLOC_GUARD_SIZE);
+            break;
+        }
+    }
+    memset(memBlock.lo, FIXALLOC_POISON, BLOCK_SIZE);
+    rec.file = nullptr;
+#endif
+    // Poison before the block becomes claimable by another thread.
+    ASAN_POISON_MEMORY_REGION(memBlock.lo, BLOCK_STRIDE);
 
     return myHeap_.releaseIdx(idxToFree) == 0;
 }
+
+template <typename HeapType>
+int BasicFixedAllocator<HeapType>::blockIndex(const MemRange memBlock) const{
+    if (!memBlock.lo || !memBlock.hi) return -1;
+    if ((memBlock.lo - &myHeap_.pool_[0]) % BLOCK_STRIDE) return -1;
+    ptrdiff_t idx = (memBlock.lo - &myHeap_.pool_[0]) / BLOCK_STRIDE;
+    if(!(idx < static_cast<ptrdiff_t>(kNumBlocks) && idx >= 0)) return -1;
+
+    return static_cast<int>(idx);
+}
+
+// Explicit instantiations so linker sees the symbols
+template struct Heap<LowestIndexPolicy>;
+template struct Heap<LifoPolicy>;
+template struct Heap<RoundRobinPolicy>;
+template struct Heap<RandomPolicy>;
+template struct Heap<LowestIndexPolicy, 4096>;
+template struct Heap<LowestIndexPolicy, 1 << 20>;
+
+template struct StackHeap<>;
+template struct StackHeap<4096>;
+template struct StackHeap<1 << 20>;
+
+template class BasicFixedAllocator<Heap<LowestIndexPolicy>>;
+template class BasicFixedAllocator<Heap<LifoPolicy>>;
+template class BasicFixedAllocator<Heap<RoundRobinPolicy>>;
+template class BasicFixedAllocator<Heap<RandomPolicy>>;
+template class BasicFixedAllocator<Heap<LowestIndexPolicy, 4096>>;
+template class BasicFixedAllocator<Heap<LowestIndexPolicy, 1 << 20>>;
+
+template class BasicFixedAllocator<StackHeap<>>;
+template class BasicFixedAllocator<StackHeap<4096>>;
+template class BasicFixedAllocator<StackHeap<1 << 20>>;
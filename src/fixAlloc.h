@@ -5,16 +5,139 @@
 #include <utility>
 #include <cstddef>
 #include <atomic>
+#ifdef FIXALLOC_DEBUG
+#include <thread>
+#endif
 
 #define BLOCK_SIZE 64
 #define NUM_BLOCKS 64
 
+// Debug mode (-DFIXALLOC_DEBUG): every block is followed by a canary guard,
+// freed blocks are filled with poison and checked on reuse, each live block
+// remembers its allocating thread and call site, and the allocator prints a
+// leak report when destroyed. Without the flag none of this is compiled in
+// and the pool layout is unchanged.
+//
+// The recorded site is the direct caller of my_malloc. Wrappers that should
+// report their own caller instead take FIXALLOC_TRAILING_CALL_SITE as their
+// last parameter and pass FIXALLOC_FORWARD_SITE on to my_malloc (or
+// FIXALLOC_TRAILING_FORWARD_SITE on to another wrapper).
+#ifdef FIXALLOC_DEBUG
+#define FIXALLOC_GUARD_SIZE 16
+#define FIXALLOC_POISON     0xDD   // freed block
+#define FIXALLOC_ALLOC_FILL 0xCD   // freshly allocated block
+#define FIXALLOC_CANARY     0xFD   // guard bytes
+#define FIXALLOC_CALL_SITE  const char* file = __builtin_FILE(), int line = __builtin_LINE()
+#define FIXALLOC_TRAILING_CALL_SITE , FIXALLOC_CALL_SITE
+#define FIXALLOC_FORWARD_SITE file, line
+#define FIXALLOC_TRAILING_FORWARD_SITE , FIXALLOC_FORWARD_SITE
+#else
+#define FIXALLOC_GUARD_SIZE 0
+#define FIXALLOC_CALL_SITE
+#define FIXALLOC_TRAILING_CALL_SITE
+#define FIXALLOC_FORWARD_SITE
+#define FIXALLOC_TRAILING_FORWARD_SITE
+#endif
+
+#define BLOCK_STRIDE (BLOCK_SIZE + FIXALLOC_GUARD_SIZE)
+
+// Under AddressSanitizer, free blocks and guards are manually poisoned so a
+// use-after-free inside the pool is reported like one on the malloc heap.
+#if defined(__SANITIZE_ADDRESS__)
+#define FIXALLOC_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FIXALLOC_ASAN 1
+#endif
+#endif
+
+// Block-selection policies. The heap asks the policy for a start hint and
+// claims the first free bit at or after it (wrapping), so every policy keeps
+// the same single-CAS claim path and only changes where the search begins.
+
+// Lowest free index first. Dense and predictable, but every thread races for
+// the same low bits.
+struct LowestIndexPolicy {
+    unsigned startHint() { return 0; }
+    void onRelease(int) {}
+};
+
+// Most-recently-freed block first, so the next allocation lands on a block
+// that is likely still in this thread's cache. Each thread keeps its own
+// stack of the last LIFO_DEPTH blocks it freed, tagged with the heap they
+// belong to, so releases never write shared state. Blocks freed by another
+// thread are not on the stack; with nothing to pop the search starts at 0.
+#define LIFO_DEPTH 64
+
+struct LifoPolicy {
+    LifoPolicy();
+    unsigned startHint();
+    void onRelease(int idx);
+
+private:
+    uint32_t id_;   // distinguishes this heap's entries on the thread stacks
+};
+
+// Per-thread rotating start offset; threads begin at different bits and
+// walk forward, spreading CAS traffic across the bitmap.
+struct RoundRobinPolicy {
+    unsigned startHint();
+    void onRelease(int) {}
+};
+
+// Per-thread xorshift start offset.
+struct RandomPolicy {
+    unsigned startHint();
+    void onRelease(int) {}
+};
+
+// Bitmap backend: one bit per block, 64 blocks per metadata word. Claims
+// are O(1) inside a word; across words, the next non-full word is found
+// with a SIMD scan (bitScan.h), 512 bits per step. The words are plain
+// uint64_t updated through __atomic builtins so the scan can read the same
+// objects; bitScan.cpp explains what that read relies on.
+template <typename SelectPolicy, size_t NumBlocks = NUM_BLOCKS>
 struct Heap {
-    uint8_t pool_[NUM_BLOCKS * BLOCK_SIZE] = {0};
-    std::atomic<uint64_t> metadata_{0};
+    static_assert(NumBlocks % 64 == 0, "Heap needs a whole number of metadata words");
+    static constexpr size_t kNumBlocks = NumBlocks;
+    static constexpr size_t kNumWords = NumBlocks / 64;
+
+    uint8_t pool_[NumBlocks * BLOCK_STRIDE] = {0};
+    uint64_t metadata_[kNumWords] = {0};
+    // Kept off the metadata lines so counting a failed CAS does not add
+    // traffic to the line the CAS just lost on.
+    alignas(64) std::atomic<uint64_t> casRetries_{0};
+    alignas(64) SelectPolicy policy_;
 
     int claimFirstFreeIdx();
     int releaseIdx(int idx);
+    size_t blocksInUse() const;
+
+private:
+    int claimInWord(size_t word, unsigned startBit);
+    int claimInRange(size_t fromWord, size_t toWord);
+};
+
+// Treiber-stack backend: free blocks are linked through a side array of
+// next indices and popped/pushed with one CAS on a tagged head, so claim
+// and release are O(1) at any pool size. The head packs the top index in
+// the low 32 bits and a modification counter in the high 32 bits (ABA).
+template <size_t NumBlocks = NUM_BLOCKS>
+struct StackHeap {
+    static_assert(NumBlocks < 0xFFFFFFFFULL, "StackHeap indices are 32-bit");
+    static constexpr size_t kNumBlocks = NumBlocks;
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+    uint8_t pool_[NumBlocks * BLOCK_STRIDE] = {0};
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint32_t> next_[NumBlocks];
+    std::atomic<bool> inUse_[NumBlocks] = {};
+    std::atomic<uint64_t> casRetries_{0};
+
+    StackHeap();
+    int claimFirstFreeIdx();
+    int releaseIdx(int idx);
+    size_t blocksInUse() const;
 };
 
 struct MemRange {
@@ -22,12 +145,48 @@ struct MemRange {
     uint8_t* hi = nullptr;
 };
 
-class FixedAllocator{
+template <typename HeapType>
+class BasicFixedAllocator{
 public:
-    FixedAllocator();
-    MemRange my_malloc();
+    static constexpr size_t kNumBlocks = HeapType::kNumBlocks;
+
+    BasicFixedAllocator();
+#if defined(FIXALLOC_DEBUG) || defined(FIXALLOC_ASAN)
+    ~BasicFixedAllocator();
+#endif
+    MemRange my_malloc(FIXALLOC_CALL_SITE);
     bool my_free(const MemRange memBlock);
 
+    // Pool index of an allocator-issued block, or -1 if it is not one.
+    int blockIndex(const MemRange memBlock) const;
+
+    // Lock-free snapshot of claimed blocks; may lag concurrent claims.
+    size_t blocksInUse() const { return myHeap_.blocksInUse(); }
+
+    // Failed CAS attempts on the heap metadata since construction.
+    uint64_t casRetries() const { return myHeap_.casRetries_.load(std::memory_order_relaxed); }
+
+#ifdef FIXALLOC_DEBUG
+    // Canary or poison violations reported since construction.
+    size_t debugErrors() const { return debugErrors_.load(); }
+#endif
+
 private:
-    Heap myHeap_;
+    HeapType myHeap_;
+
+#ifdef FIXALLOC_DEBUG
+    struct BlockRecord {
+        std::thread::id owner;
+        const char* file = nullptr;   // nullptr while the block is free
+        int line = 0;
+    };
+
+    void reportError(const char* what, int idx);
+
+    BlockRecord records_[kNumBlocks];
+    std::atomic<size_t> debugErrors_{0};
+#endif
 };
+
+using FixedAllocator = BasicFixedAllocator<Heap<LowestIndexPolicy>>;
+using StackFixedAllocator = BasicFixedAllocator<StackHeap<>>;
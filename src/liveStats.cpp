@@ -0,0 +1,120 @@
+#include "liveStats.h"
+#include <iomanip>
+
+size_t liveBucket(long ns) {
+    if (ns <= 0) return 0;
+    size_t bucket = 64 - __builtin_clzll(static_cast<unsigned long long>(ns));
+    return bucket < LIVE_HIST_BUCKETS ? bucket : LIVE_HIST_BUCKETS - 1;
+}
+
+long liveBucketUpperBound(size_t bucket) {
+    return bucket == 0 ? 0 : (1L << bucket) - 1;
+}
+
+long histogramPercentile(const std::vector<uint64_t>& counts, double p) {
+    uint64_t total = 0;
+    for (uint64_t c : counts) total += c;
+    if (total == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(total * p);
+    uint64_t seen = 0;
+    for (size_t b = 0; b < counts.size(); ++b) {
+        seen += counts[b];
+        if (seen > target) return liveBucketUpperBound(b);
+    }
+    return liveBucketUpperBound(counts.size() - 1);
+}
+
+LiveReporter::LiveReporter(size_t numThreads, std::chrono::milliseconds interval,
+                           std::ostream& out)
+    : threads_(new LiveCounters[numThreads]),
+      numThreads_(numThreads),
+      interval_(interval),
+      out_(out) {}
+
+LiveReporter::~LiveReporter() {
+    stop();
+}
+
+void LiveReporter::start() {
+    began_ = std::chrono::steady_clock::now();
+    out_ << "t_ms,sent_per_s,dropped_per_s,drop_pct,received_per_s,queue_depth,pool_in_use,"
+            "enq_p50_ns,enq_p99_ns,deq_p50_ns,deq_p99_ns\n";
+    worker_ = std::thread(&LiveReporter::loop, this);
+}
+
+void LiveReporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+LiveReporter::Snapshot LiveReporter::collect() const {
+    Snapshot s;
+    for (size_t t = 0; t < numThreads_; ++t) {
+        const LiveCounters& c = threads_[t];
+        s.sent     += c.sent.load(std::memory_order_relaxed);
+        s.dropped  += c.dropped.load(std::memory_order_relaxed);
+        s.received += c.received.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < LIVE_HIST_BUCKETS; ++b) {
+            s.enqueue_hist[b] += c.enqueue_hist[b].load(std::memory_order_relaxed);
+            s.dequeue_hist[b] += c.dequeue_hist[b].load(std::memory_order_relaxed);
+        }
+    }
+    return s;
+}
+
+void LiveReporter::report(const Snapshot& now, const Snapshot& prev, double intervalSecs) {
+    uint64_t sent     = now.sent - prev.sent;
+    uint64_t dropped  = now.dropped - prev.dropped;
+    uint64_t received = now.received - prev.received;
+
+    std::vector<uint64_t> enq(LIVE_HIST_BUCKETS), deq(LIVE_HIST_BUCKETS);
+    for (size_t b = 0; b < LIVE_HIST_BUCKETS; ++b) {
+        enq[b] = now.enqueue_hist[b] - prev.enqueue_hist[b];
+        deq[b] = now.dequeue_hist[b] - prev.dequeue_hist[b];
+    }
+
+    // Counters are read without a barrier, so received can briefly run ahead.
+    uint64_t depth = now.sent > now.received ? now.sent - now.received : 0;
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - began_).count();
+    double secs = intervalSecs > 0 ? intervalSecs : 1.0;
+
+    out_ << elapsed << ","
+         << std::fixed << std::setprecision(0)
+         << sent / secs << ","
+         << dropped / secs << ","
+         << std::setprecision(2)
+         << (sent + dropped ? 100.0 * dropped / (sent + dropped) : 0.0) << ","
+         << std::setprecision(0)
+         << received / secs << ","
+         << depth << ","
+         << (poolProbe_ ? static_cast<long long>(poolProbe_()) : -1) << ","
+         << histogramPercentile(enq, 0.50) << ","
+         << histogramPercentile(enq, 0.99) << ","
+         << histogramPercentile(deq, 0.50) << ","
+         << histogramPercentile(deq, 0.99) << "\n";
+    out_.flush();
+}
+
+void LiveReporter::loop() {
+    Snapshot prev;
+    auto last = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        bool stopping = wake_.wait_for(lock, interval_, [this] { return stopping_; });
+
+        auto now = std::chrono::steady_clock::now();
+        Snapshot snap = collect();
+        report(snap, prev, std::chrono::duration<double>(now - last).count());
+        prev = std::move(snap);
+        last = now;
+
+        if (stopping) break;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#define LIVE_HIST_BUCKETS 32
+
+// Log2 latency bucket: bucket b holds samples in [2^(b-1), 2^b) ns.
+size_t liveBucket(long ns);
+long liveBucketUpperBound(size_t bucket);
+
+// Upper bound (ns) of the bucket holding quantile p of the counts, or 0.
+long histogramPercentile(const std::vector<uint64_t>& counts, double p);
+
+// Cumulative counters for one thread. Only the owning thread writes, with a
+// relaxed load + store, so there is no lock and no locked RMW on the hot
+// path; the reporter reads them concurrently. Cache-line aligned so
+// neighbouring threads do not false-share.
+struct alignas(64) LiveCounters {
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> enqueue_hist[LIVE_HIST_BUCKETS] = {};
+    std::atomic<uint64_t> dequeue_hist[LIVE_HIST_BUCKETS] = {};
+
+    void record_enqueue(long ns, bool success) {
+        bump(enqueue_hist[liveBucket(ns)]);
+        bump(success ? sent : dropped);
+    }
+
+    void record_dequeue(long ns, bool success) {
+        bump(dequeue_hist[liveBucket(ns)]);
+        if (success) bump(received);
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// Background thread that, every interval, sums the per-thread counters and
+// writes one CSV row: throughput, drop rate, queue depth (sent - received),
+// pool occupancy and interval latency percentiles from the histogram
+// deltas. It only reads, so producers and consumers never wait on it.
+class LiveReporter {
+public:
+    LiveReporter(size_t numThreads, std::chrono::milliseconds interval, std::ostream& out);
+    ~LiveReporter();
+
+    LiveCounters& counters(size_t thread) { return threads_[thread]; }
+
+    // Optional lock-free probe for blocks currently taken from the pool.
+    void setPoolProbe(std::function<size_t()> probe) { poolProbe_ = std::move(probe); }
+
+    void start();
+    // Stops the thread and writes a final row for the partial interval.
+    void stop();
+
+private:
+    struct Snapshot {
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+        uint64_t received = 0;
+        std::vector<uint64_t> enqueue_hist = std::vector<uint64_t>(LIVE_HIST_BUCKETS, 0);
+        std::vector<uint64_t> dequeue_hist = std::vector<uint64_t>(LIVE_HIST_BUCKETS, 0);
+    };
+
+    Snapshot collect() const;
+    void report(const Snapshot& now, const Snapshot& prev, double intervalSecs);
+    void loop();
+
+    std::unique_ptr<LiveCounters[]> threads_;
+    size_t numThreads_;
+    std::chrono::milliseconds interval_;
+    std::ostream& out_;
+    std::function<size_t()> poolProbe_;
+
+    std::chrono::steady_clock::time_point began_;
+    std::thread worker_;
+    std::mutex mtx_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
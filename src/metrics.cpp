@@ -2,6 +2,7 @@
 #include <numeric>
 #include <algorithm>
 #include <iomanip>
+#include <string>
 
 void Metrics::merge(ThreadMetrics& tm) {
     std::lock_guard<std::mutex> lock(mtx);
@@ -14,13 +15,21 @@ void Metrics::merge(ThreadMetrics& tm) {
                                  tm.dequeue_latencies.begin(),
                                  tm.dequeue_latencies.end());
 
+    if (all_lane_latencies.size() < tm.lane_latencies.size())
+        all_lane_latencies.resize(tm.lane_latencies.size());
+    for (size_t lane = 0; lane < tm.lane_latencies.size(); ++lane) {
+        all_lane_latencies[lane].insert(all_lane_latencies[lane].end(),
+                                        tm.lane_latencies[lane].begin(),
+                                        tm.lane_latencies[lane].end());
+    }
+
     total_sent     += tm.sent;
     total_dropped  += tm.dropped;
     total_received += tm.received;
 }
 
 static void report_stats(const std::vector<long>& v,
-                         const char* label,
+                         const std::string& label,
                          std::ostream& out) {
     if (v.empty()) return;
 
@@ -53,4 +62,10 @@ void Metrics::summarize(std::ostream& out) {
 
     report_stats(all_enqueue_latencies, "Enqueue", out);
     report_stats(all_dequeue_latencies, "Dequeue", out);
+
+    for (size_t lane = 0; lane < all_lane_latencies.size(); ++lane) {
+        if (all_lane_latencies[lane].empty()) continue;
+        out << "Lane " << lane << " samples: " << all_lane_latencies[lane].size() << "\n";
+        report_stats(all_lane_latencies[lane], "Lane " + std::to_string(lane) + " queued", out);
+    }
 }
@@ -5,26 +5,37 @@
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
+#include "liveStats.h"
 
 // Per-thread collector
 struct ThreadMetrics {
     std::vector<long> enqueue_latencies;
     std::vector<long> dequeue_latencies;
+    std::vector<std::vector<long>> lane_latencies;  // time queued, per lane
 
     size_t sent     = 0;
     size_t dropped  = 0;
     size_t received = 0;
 
+    LiveCounters* live = nullptr;  // set when a LiveReporter is attached
+
     void record_enqueue(long ns, bool success) {
+        if (live) live->record_enqueue(ns, success);
         enqueue_latencies.push_back(ns);
         if (success) ++sent;
         else ++dropped;
     }
 
     void record_dequeue(long ns, bool success) {
+        if (live) live->record_dequeue(ns, success);
         dequeue_latencies.push_back(ns);
         if (success) ++received;
     }
+
+    void record_lane(size_t lane, long ns) {
+        if (lane >= lane_latencies.size()) lane_latencies.resize(lane + 1);
+        lane_latencies[lane].push_back(ns);
+    }
 };
 
 // Global aggregator
@@ -33,11 +44,17 @@ public:
     void merge(ThreadMetrics& tm);
     void summarize(std::ostream& out);
 
+    size_t received() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return total_received;
+    }
+
 private:
     mutable std::mutex mtx;
 
     std::vector<long> all_enqueue_latencies;
     std::vector<long> all_dequeue_latencies;
+    std::vector<std::vector<long>> all_lane_latencies;
 
     size_t total_sent     = 0;
     size_t total_dropped  = 0;
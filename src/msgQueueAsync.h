@@ -0,0 +1,172 @@
+#pragma once
+
+#include <coroutine>
+#include <mutex>
+#include "../src/msgQueueFixAlloc.h"
+#include "../src/scheduler.h"
+
+// Coroutine front end for a fixed-pool queue:
+//
+//     co_await q.async_enqueue(data);   // suspends while the queue is full
+//     co_await q.async_dequeue(out);    // suspends while it is empty
+//
+// A parked coroutine is completed by the opposite side: a successful
+// enqueue dequeues straight into a waiting consumer's buffer, a successful
+// dequeue pushes a waiting producer's message, and the waiter is posted
+// back to the scheduler it suspended on. Buffers must stay valid until the
+// co_await completes. The wait-list mutex also serializes the wrapped
+// queue, so the default queue carries no lock of its own.
+template <typename QueueType = BasicMessageQueueFixAlloc<FixedAllocator, NullMutex>>
+class AsyncMessageQueue {
+public:
+    class Awaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        // Completes inline (returns false) when the operation can proceed
+        // now; otherwise parks the coroutine.
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            scheduler = Scheduler::current();
+            return isProducer ? q.suspendEnqueue(this) : q.suspendDequeue(this);
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AsyncMessageQueue;
+
+        Awaiter(AsyncMessageQueue& queue, uint8_t* buf, bool producer)
+            : q(queue), buffer(buf), isProducer(producer) {}
+
+        void wake() {
+            if (scheduler) scheduler->post(handle);
+            else handle.resume();
+        }
+
+        AsyncMessageQueue& q;
+        uint8_t* buffer;
+        bool isProducer;
+        std::coroutine_handle<> handle;
+        Scheduler* scheduler = nullptr;
+        Awaiter* next = nullptr;
+    };
+
+    Awaiter async_enqueue(const uint8_t* data) {
+        return Awaiter(*this, const_cast<uint8_t*>(data), true);
+    }
+
+    Awaiter async_dequeue(uint8_t* out_data) {
+        return Awaiter(*this, out_data, false);
+    }
+
+    // Non-suspending variants that still hand off to parked coroutines.
+    bool enqueue(const uint8_t* data) {
+        Awaiter* woken = nullptr;
+        bool ok;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ok = enqueueLocked(data, woken);
+        }
+        wakeAll(woken);
+        return ok;
+    }
+
+    bool dequeue(uint8_t* out_data) {
+        Awaiter* woken = nullptr;
+        bool ok;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ok = dequeueLocked(out_data, woken);
+        }
+        wakeAll(woken);
+        return ok;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queue.size();
+    }
+
+private:
+    struct WaitList {
+        Awaiter* head = nullptr;
+        Awaiter* tail = nullptr;
+
+        void push(Awaiter* a) {
+            a->next = nullptr;
+            if (tail) tail->next = a;
+            else head = a;
+            tail = a;
+        }
+
+        Awaiter* pop() {
+            Awaiter* a = head;
+            head = a->next;
+            if (!head) tail = nullptr;
+            return a;
+        }
+    };
+
+    bool suspendEnqueue(Awaiter* a) {
+        Awaiter* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!enqueueLocked(a->buffer, woken)) {
+                producers.push(a);
+                return true;
+            }
+        }
+        wakeAll(woken);
+        return false;
+    }
+
+    bool suspendDequeue(Awaiter* a) {
+        Awaiter* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!dequeueLocked(a->buffer, woken)) {
+                consumers.push(a);
+                return true;
+            }
+        }
+        wakeAll(woken);
+        return false;
+    }
+
+    // Caller holds mtx. Completed waiters are chained onto `woken` and must
+    // be woken after the lock is dropped.
+    bool enqueueLocked(const uint8_t* data, Awaiter*& woken) {
+        if (!queue.enqueue(data)) return false;
+        while (consumers.head && queue.dequeue(consumers.head->buffer)) {
+            chain(consumers.pop(), woken);
+        }
+        return true;
+    }
+
+    bool dequeueLocked(uint8_t* out_data, Awaiter*& woken) {
+        if (!queue.dequeue(out_data)) return false;
+        while (producers.head && queue.enqueue(producers.head->buffer)) {
+            chain(producers.pop(), woken);
+        }
+        return true;
+    }
+
+    static void chain(Awaiter* a, Awaiter*& woken) {
+        a->next = woken;
+        woken = a;
+    }
+
+    static void wakeAll(Awaiter* woken) {
+        while (woken) {
+            Awaiter* next = woken->next;
+            woken->wake();
+            woken = next;
+        }
+    }
+
+    QueueType queue;
+    WaitList producers;
+    WaitList consumers;
+    mutable std::mutex mtx;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include "../src/fixAlloc.h"
+
+// What publish() does when the slowest subscriber is a full ring behind.
+enum class SlowSubscriberPolicy {
+    Drop,             // reject the new message
+    Block,            // wait until the slowest subscriber catches up
+    OverwriteOldest   // skip the slowest subscribers past their oldest message,
+                      // unless that would not free a pool block (then drop)
+};
+
+// One-to-many queue over a FixedAllocator pool. A message is copied into a
+// pool block once; every subscriber reads it through its own cursor, and
+// the block goes back to the allocator when the last subscriber releases
+// it. Per-block reference counts live in a side array so release() does not
+// take the queue lock. An unknown subscriber id reads as caught up.
+template <SlowSubscriberPolicy Policy = SlowSubscriberPolicy::Drop,
+          typename AllocatorType = FixedAllocator>
+class BroadcastQueueFixAlloc {
+public:
+    static constexpr size_t kCapacity = AllocatorType::kNumBlocks;
+
+    explicit BroadcastQueueFixAlloc(size_t numSubscribers)
+        : cursors(numSubscribers, 0), tail(0), dropped_(0), overwritten_(0) {}
+
+    ~BroadcastQueueFixAlloc() {
+        for (auto& cursor : cursors) {
+            while (cursor < tail) release(ring[cursor++ % kCapacity]);
+        }
+    }
+
+    bool publish(const uint8_t* data FIXALLOC_TRAILING_CALL_SITE) {
+        std::unique_lock<std::mutex> lock(mtx);
+
+        // Nobody to deliver to: taking a block would leak it, since no
+        // subscriber will ever release it.
+        if (cursors.empty()) return true;
+
+        MemRange r;
+        while (true) {
+            if (tail - minCursor() >= kCapacity) {
+                if constexpr (Policy == SlowSubscriberPolicy::Drop) {
+                    ++dropped_;
+                    return false;
+                } else if constexpr (Policy == SlowSubscriberPolicy::Block) {
+                    progress.wait(lock);
+                    continue;
+                } else {
+                    // Only skip the slow subscribers if a block will be
+                    // there to publish into; otherwise they would lose a
+                    // message and the publish would still fail.
+                    if (alloc_.blocksInUse() >= kCapacity && !evictionFreesBlock()) {
+                        ++dropped_;
+                        return false;
+                    }
+                    evictOldest();
+                }
+            }
+
+            r = alloc_.my_malloc(FIXALLOC_FORWARD_SITE);
+            if (r.lo) break;
+
+            // Pool exhausted by blocks subscribers still hold.
+            if constexpr (Policy == SlowSubscriberPolicy::Block) {
+                progress.wait(lock);
+            } else {
+                ++dropped_;
+                return false;
+            }
+        }
+
+        memcpy(r.lo, data, BLOCK_SIZE);
+        refs[alloc_.blockIndex(r)].store(static_cast<uint32_t>(cursors.size()));
+        ring[tail % kCapacity] = r;
+        ++tail;
+        return true;
+    }
+
+    // Zero-copy read: returns the subscriber's next block, or an empty range
+    // if it is caught up. The caller must hand the block back via release().
+    MemRange acquire(size_t subscriber) {
+        MemRange r;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (subscriber >= cursors.size()) return r;
+            uint64_t& cursor = cursors[subscriber];
+            if (cursor == tail) return r;
+            r = ring[cursor % kCapacity];
+            ++cursor;
+        }
+        if constexpr (Policy == SlowSubscriberPolicy::Block) progress.notify_all();
+        return r;
+    }
+
+    // Drops one reference; the last one returns the block to the pool.
+    bool release(const MemRange r) {
+        int idx = alloc_.blockIndex(r);
+        if (idx == -1) return false;
+
+        uint32_t count = refs[idx].load();
+        do {
+            if (count == 0) return false;
+        } while (!refs[idx].compare_exchange_weak(count, count - 1));
+
+        if (count == 1) {
+            alloc_.my_free(r);
+            if constexpr (Policy == SlowSubscriberPolicy::Block) {
+                { std::lock_guard<std::mutex> lock(mtx); }
+                progress.notify_all();
+            }
+        }
+        return true;
+    }
+
+    // Copying read, same contract as MessageQueueFixAlloc::dequeue.
+    bool receive(size_t subscriber, uint8_t* out_data) {
+        MemRange r = acquire(subscriber);
+        if (!r.lo) return false;
+        memcpy(out_data, r.lo, BLOCK_SIZE);
+        return release(r);
+    }
+
+    // Messages published but not yet read by this subscriber.
+    size_t lag(size_t subscriber) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (subscriber >= cursors.size()) return 0;
+        return tail - cursors[subscriber];
+    }
+
+    size_t dropped() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return dropped_;
+    }
+
+    // Messages skipped on behalf of slow subscribers (OverwriteOldest).
+    size_t overwritten() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return overwritten_;
+    }
+
+    size_t subscribers() const { return cursors.size(); }
+
+private:
+    uint64_t minCursor() const {
+        uint64_t lowest = tail;
+        for (uint64_t c : cursors) lowest = c < lowest ? c : lowest;
+        return lowest;
+    }
+
+    // Caller holds mtx and the ring is full. True if the subscribers still on
+    // the oldest message hold its only references. Only the publisher
+    // allocates, and concurrent releases only lower the count, so the
+    // answer stays true until the caller evicts.
+    bool evictionFreesBlock() const {
+        uint64_t oldest = tail - kCapacity;
+        uint32_t waiting = 0;
+        for (uint64_t c : cursors) waiting += c == oldest;
+        return refs[alloc_.blockIndex(ring[oldest % kCapacity])].load() == waiting;
+    }
+
+    // Caller holds mtx and the ring is full.
+    void evictOldest() {
+        uint64_t oldest = tail - kCapacity;
+        for (auto& cursor : cursors) {
+            if (cursor != oldest) continue;
+            release(ring[oldest % kCapacity]);
+            ++cursor;
+            ++overwritten_;
+        }
+    }
+
+    MemRange ring[kCapacity];
+    std::atomic<uint32_t> refs[kCapacity] = {};
+    AllocatorType alloc_;
+    std::vector<uint64_t> cursors;
+    uint64_t tail;
+    size_t dropped_;
+    size_t overwritten_;
+    mutable std::mutex mtx;
+    std::condition_variable progress;
+};
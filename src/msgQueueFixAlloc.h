@@ -1,31 +1,45 @@
+#pragma once
+
 #include <cstring>
 #include <mutex>
 #include "../src/fixAlloc.h"
 
 #define QUEUE_MAX_SIZE NUM_BLOCKS
 
-class MessageQueueFixAlloc {
+// Lock type for a queue that is only ever touched under an outer lock.
+struct NullMutex {
+    void lock() {}
+    void unlock() {}
+};
+
+// AllocatorType selects the heap backend; the ring holds one entry per
+// pool block. MutexType is NullMutex when the caller already serializes
+// access.
+template <typename AllocatorType = FixedAllocator, typename MutexType = std::mutex>
+class BasicMessageQueueFixAlloc {
 public:
-    MessageQueueFixAlloc() : head(0), tail(0), count(0) {}
+    static constexpr size_t kCapacity = AllocatorType::kNumBlocks;
 
-    bool enqueue(const uint8_t* data) {
-        std::lock_guard<std::mutex> lock(mtx);
+    BasicMessageQueueFixAlloc() : head(0), tail(0), count(0) {}
 
-        if (count >= QUEUE_MAX_SIZE) return false;
+    bool enqueue(const uint8_t* data FIXALLOC_TRAILING_CALL_SITE) {
+        std::lock_guard<MutexType> lock(mtx);
 
-        MemRange r = alloc_.my_malloc();
+        if (count >= kCapacity) return false;
+
+        MemRange r = alloc_.my_malloc(FIXALLOC_FORWARD_SITE);
         if (!r.lo) return false;
 
         memcpy(r.lo, data, BLOCK_SIZE);
         entries[tail] = r;
 
-        tail = (tail + 1) % QUEUE_MAX_SIZE;
+        tail = (tail + 1) % kCapacity;
         ++count;
         return true;
     }
 
     bool dequeue(uint8_t* out_data) {
-        std::lock_guard<std::mutex> lock(mtx);
+        std::lock_guard<MutexType> lock(mtx);
 
         if (count == 0) return false;
 
@@ -34,21 +48,27 @@ public:
         bool freed = alloc_.my_free(r);
         if (!freed) return false;
 
-        head = (head + 1) % QUEUE_MAX_SIZE;
+        head = (head + 1) % kCapacity;
         --count;
         return true;
     }
 
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mtx);
+        std::lock_guard<MutexType> lock(mtx);
         return count;
     }
 
+    // Pool blocks in use, read without taking the queue lock.
+    size_t poolInUse() const { return alloc_.blocksInUse(); }
+
 private:
-    MemRange entries[QUEUE_MAX_SIZE];
-    FixedAllocator alloc_;
+    MemRange entries[kCapacity];
+    AllocatorType alloc_;
     size_t head;
     size_t tail;
-    uint16_t count;
-    mutable std::mutex mtx;  
+    size_t count;
+    mutable MutexType mtx;
 };
+
+using MessageQueueFixAlloc = BasicMessageQueueFixAlloc<>;
+using MessageQueueStackAlloc = BasicMessageQueueFixAlloc<StackFixedAllocator>;
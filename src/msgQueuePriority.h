@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstring>
+#include <mutex>
+#include <chrono>
+#include "../src/fixAlloc.h"
+
+// K FIFO lanes sharing one FixedAllocator pool. Lane 0 is the most urgent.
+// A bit per non-empty lane lets dequeue find the highest-priority lane with
+// one count-trailing-zeros. An optional per-lane block quota stops bulk
+// lanes from taking the whole pool and starving urgent ones. Out-of-range
+// lanes are rejected: enqueue fails, setLaneQuota is ignored, size() is 0.
+template <size_t NumLanes, typename AllocatorType = FixedAllocator>
+class PriorityMessageQueueFixAlloc {
+    static_assert(NumLanes >= 1 && NumLanes <= 32, "lane mask is 32 bits");
+
+public:
+    static constexpr size_t kLanes = NumLanes;
+    static constexpr size_t kCapacity = AllocatorType::kNumBlocks;
+
+    PriorityMessageQueueFixAlloc() : laneMask(0) {
+        for (Lane& l : lanes) {
+            l.head = l.tail = l.count = 0;
+            l.quota = kCapacity;
+        }
+    }
+
+    // Caps the number of pool blocks `lane` may hold at once.
+    void setLaneQuota(size_t lane, size_t maxBlocks) {
+        if (lane >= kLanes) return;
+        std::lock_guard<std::mutex> lock(mtx);
+        lanes[lane].quota = maxBlocks < kCapacity ? maxBlocks : kCapacity;
+    }
+
+    bool enqueue(size_t lane, const uint8_t* data FIXALLOC_TRAILING_CALL_SITE) {
+        if (lane >= kLanes) return false;
+        std::lock_guard<std::mutex> lock(mtx);
+
+        Lane& l = lanes[lane];
+        if (l.count >= l.quota) return false;
+
+        MemRange r = alloc_.my_malloc(FIXALLOC_FORWARD_SITE);
+        if (!r.lo) return false;
+
+        memcpy(r.lo, data, BLOCK_SIZE);
+        l.entries[l.tail] = {r, std::chrono::steady_clock::now()};
+
+        l.tail = (l.tail + 1) % kCapacity;
+        ++l.count;
+        laneMask |= 1u << lane;
+        return true;
+    }
+
+    // Dequeues from the highest-priority non-empty lane. Optionally reports
+    // which lane it came from and how long it sat in the queue.
+    bool dequeue(uint8_t* out_data, size_t* out_lane = nullptr, long* queued_ns = nullptr) {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (laneMask == 0) return false;
+
+        size_t lane = __builtin_ctz(laneMask);
+        Lane& l = lanes[lane];
+        Entry e = l.entries[l.head];
+        memcpy(out_data, e.block.lo, BLOCK_SIZE);
+        bool freed = alloc_.my_free(e.block);
+        if (!freed) return false;
+
+        l.head = (l.head + 1) % kCapacity;
+        if (--l.count == 0) laneMask &= ~(1u << lane);
+
+        if (out_lane) *out_lane = lane;
+        if (queued_ns) {
+            *queued_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - e.enqueuedAt).count();
+        }
+        return true;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t total = 0;
+        for (const Lane& l : lanes) total += l.count;
+        return total;
+    }
+
+    size_t size(size_t lane) const {
+        if (lane >= kLanes) return 0;
+        std::lock_guard<std::mutex> lock(mtx);
+        return lanes[lane].count;
+    }
+
+private:
+    struct Entry {
+        MemRange block;
+        std::chrono::steady_clock::time_point enqueuedAt;
+    };
+
+    struct Lane {
+        Entry entries[kCapacity];
+        size_t head;
+        size_t tail;
+        size_t count;
+        size_t quota;
+    };
+
+    Lane lanes[NumLanes];
+    AllocatorType alloc_;
+    uint32_t laneMask;
+    mutable std::mutex mtx;
+};
@@ -0,0 +1,71 @@
+#include "scheduler.h"
+
+static thread_local Scheduler* tlsCurrent = nullptr;
+
+std::suspend_never Task::promise_type::final_suspend() noexcept {
+    scheduler->live.fetch_sub(1);
+    return {};
+}
+
+static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+void Scheduler::spawn(Task task) {
+    auto h = std::exchange(task.handle, nullptr);
+    h.promise().scheduler = this;
+    live.fetch_add(1);
+    post(h);
+}
+
+void Scheduler::post(std::coroutine_handle<> h) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        ready.push_back(h);
+        pending.fetch_add(1, std::memory_order_release);
+        wake = parked;
+    }
+    if (wake) readyCv.notify_one();
+}
+
+void Scheduler::run() {
+    Scheduler* previous = tlsCurrent;
+    tlsCurrent = this;
+
+    std::deque<std::coroutine_handle<>> batch;
+    size_t idlePolls = 0;
+    while (live.load() > 0) {
+        if (pending.load(std::memory_order_acquire) == 0 && idlePolls < SCHED_IDLE_SPINS) {
+            ++idlePolls;
+            cpuRelax();
+            continue;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            if (ready.empty()) {
+                parked = true;
+                readyCv.wait(lock, [this] { return !ready.empty() || live.load() == 0; });
+                parked = false;
+            }
+            batch.swap(ready);
+            pending.store(0, std::memory_order_relaxed);
+        }
+        idlePolls = 0;
+        while (!batch.empty()) {
+            std::coroutine_handle<> next = batch.front();
+            batch.pop_front();
+            next.resume();
+        }
+    }
+
+    tlsCurrent = previous;
+}
+
+Scheduler* Scheduler::current() {
+    return tlsCurrent;
+}
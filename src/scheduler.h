@@ -0,0 +1,79 @@
+#pragma once
+
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#define SCHED_IDLE_SPINS 1024
+
+class Scheduler;
+
+// Fire-and-forget coroutine. Starts suspended; Scheduler::spawn takes
+// ownership and the frame frees itself when the body returns. A Task that
+// is never spawned destroys its frame when it goes out of scope.
+struct Task {
+    struct promise_type {
+        Scheduler* scheduler = nullptr;
+
+        Task get_return_object() {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept;
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Minimal run-queue scheduler: one thread calls run() and resumes ready
+// coroutines in FIFO order. post() may be called from any thread, which is
+// how a queue on one side wakes a coroutine parked by the other side.
+// post() pushes under a mutex and bumps an atomic pending count. run()
+// polls only the count while idle and takes the mutex once per batch to
+// swap the whole run queue out, so a waker can only collide with that swap,
+// never with an idle poll or a running coroutine. After SCHED_IDLE_SPINS
+// empty polls the scheduler parks on a condition variable; only a post()
+// to a parked scheduler pays for a futex wake.
+class Scheduler {
+public:
+    void spawn(Task task);
+    void post(std::coroutine_handle<> h);
+
+    // Resumes coroutines until every task spawned here has finished.
+    void run();
+
+    // Scheduler driving the calling thread, or nullptr outside run().
+    static Scheduler* current();
+
+private:
+    friend struct Task::promise_type;
+
+    std::mutex mtx;
+    std::condition_variable readyCv;
+    std::deque<std::coroutine_handle<>> ready;
+    std::atomic<size_t> pending{0};   // ready.size(), readable without mtx
+    std::atomic<size_t> live{0};
+    bool parked = false;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../src/fixAlloc.h"
+
+// NumShards independent queues behind one enqueue/dequeue interface, so a
+// producer/consumer set no longer serializes on a single queue lock.
+//
+// Producers round-robin over the shards starting from a per-thread offset
+// and spill to the next shard when one is full. Each consumer thread has a
+// home shard it drains first; when that is empty it steals from the others.
+// Producer offsets and consumer homes are numbered separately, so the Nth
+// consumer is homed on shard N % NumShards however many producers started
+// first. Shard arguments wrap, and depth/steals of a bad shard are 0.
+// Steals are counted against the shard they were taken from. In
+// FIXALLOC_DEBUG builds enqueue forwards its caller's site to the shard.
+template <typename QueueType, size_t NumShards = 4>
+class ShardedQueueGroup {
+public:
+    static constexpr size_t kShards = NumShards;
+
+    bool enqueue(const uint8_t* data FIXALLOC_TRAILING_CALL_SITE) {
+        static thread_local size_t cursor = producerSlot();
+        return enqueue(cursor++ % NumShards, data FIXALLOC_TRAILING_FORWARD_SITE);
+    }
+
+    // Tries `shard` first, then the others in order.
+    bool enqueue(size_t shard, const uint8_t* data FIXALLOC_TRAILING_CALL_SITE) {
+        for (size_t n = 0; n < NumShards; ++n) {
+            if (shards[(shard + n) % NumShards].queue.enqueue(data FIXALLOC_TRAILING_FORWARD_SITE)) return true;
+        }
+        return false;
+    }
+
+    bool dequeue(uint8_t* out_data) {
+        return dequeue(consumerSlot(), out_data);
+    }
+
+    // Drains `home` first, then steals from the other shards.
+    bool dequeue(size_t home, uint8_t* out_data) {
+        home %= NumShards;
+        if (shards[home].queue.dequeue(out_data)) return true;
+        for (size_t n = 1; n < NumShards; ++n) {
+            Shard& victim = shards[(home + n) % NumShards];
+            if (victim.queue.dequeue(out_data)) {
+                victim.stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& s : shards) total += s.queue.size();
+        return total;
+    }
+
+    size_t poolInUse() const {
+        size_t total = 0;
+        for (const Shard& s : shards) total += s.queue.poolInUse();
+        return total;
+    }
+
+    size_t depth(size_t shard) const {
+        if (shard >= NumShards) return 0;
+        return shards[shard].queue.size();
+    }
+
+    // Messages taken from `shard` by consumers homed elsewhere.
+    size_t steals(size_t shard) const {
+        if (shard >= NumShards) return 0;
+        return shards[shard].stolen.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Stable per-thread indices, handed out in first-use order; one
+    // sequence for producers and one for consumers.
+    static size_t producerSlot() {
+        static std::atomic<size_t> nextSlot{0};
+        static thread_local size_t slot = nextSlot.fetch_add(1);
+        return slot;
+    }
+
+    static size_t consumerSlot() {
+        static std::atomic<size_t> nextSlot{0};
+        static thread_local size_t slot = nextSlot.fetch_add(1) % NumShards;
+        return slot;
+    }
+
+    struct alignas(64) Shard {
+        QueueType queue;
+        std::atomic<size_t> stolen{0};
+    };
+
+    Shard shards[NumShards];
+};
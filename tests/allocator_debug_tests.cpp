@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include "../src/fixAlloc.h"
+#include "../src/msgQueueFixAlloc.h"
+
+// Built with FIXALLOC_DEBUG (see CMakeLists.txt).
+
+#ifdef FIXALLOC_ASAN
+#include <sanitizer/asan_interface.h>
+// Lets a test corrupt pool memory the way production code without ASan
+// would, so the debug-mode checks (not ASan) are what catch it.
+#define ALLOW_WRITE(addr, size) ASAN_UNPOISON_MEMORY_REGION(addr, size)
+#else
+#define ALLOW_WRITE(addr, size) ((void)(addr), (void)(size))
+#endif
+
+TEST(FixedAllocatorDebugTest, GuardSitsBetweenBlocks) {
+    FixedAllocator allocator;
+    MemRange a = allocator.my_malloc();
+    MemRange b = allocator.my_malloc();
+    ASSERT_TRUE(a.lo && b.lo);
+    EXPECT_EQ(a.hi - a.lo + 1, BLOCK_SIZE);
+    EXPECT_EQ(b.lo - a.lo, BLOCK_STRIDE);
+    EXPECT_TRUE(allocator.my_free(a));
+    EXPECT_TRUE(allocator.my_free(b));
+}
+
+TEST(FixedAllocatorDebugTest, LeakReportNamesCallSite) {
+    testing::internal::CaptureStderr();
+    int line = 0;
+    {
+        FixedAllocator allocator;
+        MemRange kept = allocator.my_malloc(); line = __LINE__;
+        MemRange freed = allocator.my_malloc();
+        ASSERT_TRUE(kept.lo && freed.lo);
+        EXPECT_TRUE(allocator.my_free(freed));
+    }
+    std::string report = testing::internal::GetCapturedStderr();
+    EXPECT_NE(report.find("leak: block 0"), std::string::npos) << report;
+    EXPECT_NE(report.find("allocator_debug_tests.cpp:" + std::to_string(line)),
+              std::string::npos) << report;
+    EXPECT_NE(report.find("1 of 64 blocks"), std::string::npos) << report;
+}
+
+TEST(FixedAllocatorDebugTest, QueueForwardsCallerSite) {
+    testing::internal::CaptureStderr();
+    int line = 0;
+    {
+        MessageQueueFixAlloc q;
+        uint8_t msg[BLOCK_SIZE] = {0x42};
+        ASSERT_TRUE(q.enqueue(msg)); line = __LINE__;
+    }
+    std::string report = testing::internal::GetCapturedStderr();
+    EXPECT_NE(report.find("allocator_debug_tests.cpp:" + std::to_string(line)),
+              std::string::npos) << report;
+    EXPECT_EQ(report.find("msgQueueFixAlloc.h"), std::string::npos) << report;
+}
+
+TEST(FixedAllocatorDebugTest, CanaryOverwriteDetectedOnFree) {
+    FixedAllocator allocator;
+    MemRange r = allocator.my_malloc();
+    ASSERT_TRUE(r.lo);
+
+    ALLOW_WRITE(r.hi + 1, 1);
+    r.hi[1] = 0x00;   // one byte past the block
+
+    testing::internal::CaptureStderr();
+    EXPECT_TRUE(allocator.my_free(r));
+    std::string report = testing::internal::GetCapturedStderr();
+    EXPECT_EQ(allocator.debugErrors(), 1u);
+    EXPECT_NE(report.find("canary overwritten: block 0"), std::string::npos) << report;
+}
+
+TEST(FixedAllocatorDebugTest, WriteAfterFreeDetectedOnReuse) {
+    FixedAllocator allocator;
+    MemRange r = allocator.my_malloc();
+    ASSERT_TRUE(r.lo);
+    EXPECT_TRUE(allocator.my_free(r));
+
+    ALLOW_WRITE(r.lo, 1);
+    r.lo[0] = 0x42;
+
+    testing::internal::CaptureStderr();
+    MemRange again = allocator.my_malloc();
+    std::string report = testing::internal::GetCapturedStderr();
+    EXPECT_EQ(again.lo, r.lo);
+    EXPECT_EQ(allocator.debugErrors(), 1u);
+    EXPECT_NE(report.find("write after free"), std::string::npos) << report;
+    EXPECT_TRUE(allocator.my_free(again));
+}
+
+TEST(FixedAllocatorDebugTest, CleanUsageReportsNothing) {
+    testing::internal::CaptureStderr();
+    {
+        StackFixedAllocator allocator;
+        for (int i = 0; i < 1000; ++i) {
+            MemRange r = allocator.my_malloc();
+            ASSERT_TRUE(r.lo);
+            memset(r.lo, i, BLOCK_SIZE);
+            EXPECT_TRUE(allocator.my_free(r));
+        }
+        EXPECT_EQ(allocator.debugErrors(), 0u);
+    }
+    EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+}
+
+#ifdef FIXALLOC_ASAN
+TEST(FixedAllocatorDebugDeathTest, AsanCatchesUseAfterFree) {
+    EXPECT_DEATH({
+        FixedAllocator allocator;
+        MemRange r = allocator.my_malloc();
+        allocator.my_free(r);
+        volatile uint8_t v = r.lo[0];
+        (void)v;
+    }, "use-after-poison");
+}
+
+TEST(FixedAllocatorDebugDeathTest, AsanCatchesOverflowIntoGuard) {
+    EXPECT_DEATH({
+        FixedAllocator allocator;
+        MemRange r = allocator.my_malloc();
+        r.hi[1] = 0;
+    }, "use-after-poison");
+}
+#endif
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <random>
 #include <thread>
+#include <memory>
 #include "../src/fixAlloc.h"
 
 #define NUM_CORES (std::thread::hardware_concurrency())
@@ -185,3 +186,148 @@ TEST(FixedAllocatorTest, ConcurrentAllocationsDoNotExceedCapacity) {
     EXPECT_FALSE(overflow_detected.load());
 }
 
+
+TEST(FixedAllocatorPolicyTest, LifoReusesMostRecentlyFreed) {
+    BasicFixedAllocator<Heap<LifoPolicy>> allocator;
+    MemRange blocks[6];
+    for (MemRange& r : blocks) {
+        r = allocator.my_malloc();
+        ASSERT_TRUE(r.lo);
+    }
+
+    // Lowest-index would hand back blocks[0] first; a last-freed hint would
+    // follow blocks[2] with an untouched block. LIFO unwinds both frees.
+    EXPECT_TRUE(allocator.my_free(blocks[0]));
+    EXPECT_TRUE(allocator.my_free(blocks[2]));
+    EXPECT_EQ(allocator.my_malloc().lo, blocks[2].lo);
+    EXPECT_EQ(allocator.my_malloc().lo, blocks[0].lo);
+}
+
+TEST(FixedAllocatorPolicyTest, LifoIgnoresOtherHeapsReleases) {
+    BasicFixedAllocator<Heap<LifoPolicy>> first;
+    BasicFixedAllocator<Heap<LifoPolicy>> second;
+    MemRange a = second.my_malloc();
+    MemRange b = second.my_malloc();
+    MemRange x = first.my_malloc();
+    MemRange y = first.my_malloc();
+    ASSERT_TRUE(a.lo && b.lo && x.lo && y.lo);
+
+    EXPECT_TRUE(second.my_free(a));
+    EXPECT_TRUE(second.my_free(b));
+    EXPECT_TRUE(first.my_free(x));
+
+    // first's release is on top of the thread stack; second's are below it.
+    EXPECT_EQ(first.my_malloc().lo, x.lo);
+    EXPECT_EQ(second.my_malloc().lo, b.lo);
+    EXPECT_EQ(second.my_malloc().lo, a.lo);
+}
+
+TEST(FixedAllocatorPolicyTest, RoundRobinSpreadsConsecutiveAllocations) {
+    BasicFixedAllocator<Heap<RoundRobinPolicy>> allocator;
+    MemRange a = allocator.my_malloc();
+    ASSERT_TRUE(a.lo);
+    EXPECT_TRUE(allocator.my_free(a));
+
+    MemRange b = allocator.my_malloc();
+    ASSERT_TRUE(b.lo);
+    EXPECT_NE(b.lo, a.lo);
+}
+
+template <typename SelectPolicy>
+static void expectExhaustsPool() {
+    BasicFixedAllocator<Heap<SelectPolicy>> allocator;
+    std::set<void*> seen;
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        MemRange r = allocator.my_malloc();
+        ASSERT_TRUE(r.lo);
+        EXPECT_TRUE(seen.insert(r.lo).second);
+    }
+    EXPECT_FALSE(allocator.my_malloc().lo);
+    for (void* p : seen) {
+        MemRange r;
+        r.lo = static_cast<uint8_t*>(p);
+        r.hi = r.lo + BLOCK_SIZE - 1;
+        EXPECT_TRUE(allocator.my_free(r));
+    }
+}
+
+TEST(FixedAllocatorPolicyTest, EveryPolicyExhaustsPoolWithoutOverlap) {
+    expectExhaustsPool<LowestIndexPolicy>();
+    expectExhaustsPool<LifoPolicy>();
+    expectExhaustsPool<RoundRobinPolicy>();
+    expectExhaustsPool<RandomPolicy>();
+}
+
+TEST(StackAllocatorTest, ExhaustiveAllocation) {
+    StackFixedAllocator allocator;
+    std::set<void*> seen;
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        MemRange r = allocator.my_malloc();
+        ASSERT_TRUE(r.lo && r.hi);
+        EXPECT_EQ(r.hi - r.lo + 1, BLOCK_SIZE);
+        EXPECT_TRUE(seen.insert(r.lo).second);
+    }
+    EXPECT_FALSE(allocator.my_malloc().lo);
+}
+
+TEST(StackAllocatorTest, DoubleFreeDetection) {
+    StackFixedAllocator allocator;
+    MemRange r = allocator.my_malloc();
+    ASSERT_TRUE(r.lo);
+    EXPECT_TRUE(allocator.my_free(r));
+    EXPECT_FALSE(allocator.my_free(r));
+}
+
+TEST(StackAllocatorTest, ReusesLastFreedBlock) {
+    StackFixedAllocator allocator;
+    MemRange a = allocator.my_malloc();
+    MemRange b = allocator.my_malloc();
+    EXPECT_TRUE(allocator.my_free(a));
+    EXPECT_TRUE(allocator.my_free(b));
+    EXPECT_EQ(allocator.my_malloc().lo, b.lo);
+    EXPECT_EQ(allocator.my_malloc().lo, a.lo);
+}
+
+TEST(StackAllocatorTest, ConcurrentAllocationsDoNotOverlap) {
+    StackFixedAllocator allocator;
+    std::atomic<bool> error_detected{false};
+
+    auto alloc_free_task = [&](int thread_idx) {
+        for (int i = 0; i < 1000; ++i) {
+            MemRange r = allocator.my_malloc();
+            if (!r.lo) continue;
+
+            uint8_t thread_id = static_cast<uint8_t>(thread_idx);
+            std::memset(r.lo, thread_id, BLOCK_SIZE);
+            for (int j = 0; j < BLOCK_SIZE; ++j) {
+                if (r.lo[j] != thread_id) error_detected.store(true);
+            }
+            if (!allocator.my_free(r)) error_detected.store(true);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::max(2, static_cast<int>(NUM_CORES)); ++i) {
+        threads.emplace_back(alloc_free_task, i);
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_FALSE(error_detected.load());
+}
+
+TEST(FixedAllocatorMultiWordTest, AllocatesAcrossMetadataWords) {
+    auto allocator = std::make_unique<BasicFixedAllocator<Heap<LowestIndexPolicy, 4096>>>();
+    std::set<void*> seen;
+    for (int i = 0; i < 4096; ++i) {
+        MemRange r = allocator->my_malloc();
+        ASSERT_TRUE(r.lo);
+        EXPECT_TRUE(seen.insert(r.lo).second);
+    }
+    EXPECT_FALSE(allocator->my_malloc().lo);
+
+    MemRange last;
+    last.lo = static_cast<uint8_t*>(*seen.rbegin());
+    last.hi = last.lo + BLOCK_SIZE - 1;
+    EXPECT_TRUE(allocator->my_free(last));
+    EXPECT_EQ(allocator->my_malloc().lo, last.lo);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "../src/msgQueueAsync.h"
+
+TEST(AsyncMessageQueueTest, DequeueSuspendsUntilEnqueue) {
+    AsyncMessageQueue<> q;
+    Scheduler sched;
+    uint8_t out[BLOCK_SIZE] = {0};
+    bool consumed = false;
+
+    auto consumer = [&]() -> Task {
+        co_await q.async_dequeue(out);
+        consumed = true;
+    };
+    auto producer = [&]() -> Task {
+        uint8_t msg[BLOCK_SIZE];
+        memset(msg, 0x42, BLOCK_SIZE);
+        co_await q.async_enqueue(msg);
+    };
+
+    sched.spawn(consumer());
+    sched.spawn(producer());
+    sched.run();
+
+    EXPECT_TRUE(consumed);
+    EXPECT_EQ(out[0], 0x42);
+    EXPECT_EQ(q.size(), 0u);
+}
+
+TEST(AsyncMessageQueueTest, EnqueueSuspendsWhileFull) {
+    AsyncMessageQueue<> q;
+    Scheduler sched;
+    uint8_t msg[BLOCK_SIZE] = {0x01};
+    uint8_t out[BLOCK_SIZE];
+    for (int i = 0; i < QUEUE_MAX_SIZE; ++i) ASSERT_TRUE(q.enqueue(msg));
+
+    bool produced = false;
+    auto producer = [&]() -> Task {
+        uint8_t last[BLOCK_SIZE];
+        memset(last, 0x99, BLOCK_SIZE);
+        co_await q.async_enqueue(last);
+        produced = true;
+    };
+    auto drain = [&]() -> Task {
+        for (int i = 0; i <= QUEUE_MAX_SIZE; ++i) {
+            co_await q.async_dequeue(out);
+        }
+    };
+
+    sched.spawn(producer());
+    sched.spawn(drain());
+    sched.run();
+
+    EXPECT_TRUE(produced);
+    EXPECT_EQ(out[0], 0x99);
+    EXPECT_EQ(q.size(), 0u);
+}
+
+TEST(AsyncMessageQueueTest, ManyCoroutinesAcrossSchedulers) {
+    AsyncMessageQueue<> q;
+    const int threads = 3;
+    const int tasksPerSide = 200;
+    const int msgsPerTask = 50;
+
+    std::vector<Scheduler> schedulers(threads);
+    std::atomic<long> sentSum{0};
+    std::atomic<long> receivedSum{0};
+
+    auto producer = [&](int id) -> Task {
+        uint8_t msg[BLOCK_SIZE];
+        for (int i = 0; i < msgsPerTask; ++i) {
+            msg[0] = static_cast<uint8_t>(id + i);
+            co_await q.async_enqueue(msg);
+            sentSum.fetch_add(msg[0]);
+        }
+    };
+    auto consumer = [&]() -> Task {
+        uint8_t out[BLOCK_SIZE];
+        for (int i = 0; i < msgsPerTask; ++i) {
+            co_await q.async_dequeue(out);
+            receivedSum.fetch_add(out[0]);
+        }
+    };
+
+    for (int t = 0; t < tasksPerSide; ++t) {
+        schedulers[t % threads].spawn(producer(t));
+        schedulers[(t + 1) % threads].spawn(consumer());
+    }
+
+    std::vector<std::thread> workers;
+    for (auto& s : schedulers) workers.emplace_back([&s]() { s.run(); });
+    for (auto& w : workers) w.join();
+
+    EXPECT_EQ(sentSum.load(), receivedSum.load());
+    EXPECT_EQ(q.size(), 0u);
+}
+
+TEST(AsyncMessageQueueTest, UnspawnedTaskFreesItsFrame) {
+    bool ran = false;
+    auto body = [&]() -> Task {
+        ran = true;
+        co_return;
+    };
+    {
+        Task t = body();
+        Task moved = std::move(t);
+        EXPECT_EQ(t.handle, nullptr);
+        EXPECT_NE(moved.handle, nullptr);
+    }
+    // The frame is destroyed without running; LeakSanitizer fails the
+    // suite if it is leaked instead.
+    EXPECT_FALSE(ran);
+}
+
+TEST(AsyncMessageQueueTest, ParkedSchedulerWakesOnCrossThreadPost) {
+    AsyncMessageQueue<> q;
+    Scheduler sched;
+    uint8_t out[BLOCK_SIZE] = {0};
+
+    auto consumer = [&]() -> Task {
+        co_await q.async_dequeue(out);
+    };
+    sched.spawn(consumer());
+
+    std::thread driver([&sched]() { sched.run(); });
+    // Long enough for the idle scheduler to exhaust its spins and park.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    uint8_t msg[BLOCK_SIZE];
+    memset(msg, 0x77, BLOCK_SIZE);
+    ASSERT_TRUE(q.enqueue(msg));
+    driver.join();
+
+    EXPECT_EQ(out[0], 0x77);
+}
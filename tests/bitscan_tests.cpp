@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/bitScan.h"
+
+#define FULL 0xFFFFFFFFFFFFFFFFULL
+
+static const BitScanKernel kAllKernels[] = {
+    BitScanKernel::Scalar, BitScanKernel::Sse42, BitScanKernel::Avx2, BitScanKernel::Avx512
+};
+
+TEST(BitScanTest, EveryKernelFindsFirstNonFullWord) {
+    BitScanKernel original = activeBitScanKernel();
+    for (BitScanKernel k : kAllKernels) {
+        if (!setBitScanKernel(k)) continue;
+        for (size_t n : {1, 7, 8, 9, 64, 1000}) {
+            for (size_t hole = 0; hole <= n; hole += (n / 5) + 1) {
+                std::vector<uint64_t> words(n, FULL);
+                if (hole < n) words[hole] = FULL & ~(1ULL << 17);
+                EXPECT_EQ(findNonFullWord(words.data(), n), hole < n ? hole : n)
+                    << bitScanKernelName(k) << " n=" << n << " hole=" << hole;
+            }
+        }
+    }
+    setBitScanKernel(original);
+}
+
+TEST(BitScanTest, ScalarKernelAlwaysSupported) {
+    EXPECT_TRUE(bitScanKernelSupported(BitScanKernel::Scalar));
+}
+
+TEST(BitScanTest, FreeRunInsideOneWord) {
+    std::vector<uint64_t> words(4, FULL);
+    words[2] = FULL & ~(0xFULL << 20);   // bits 148..151 clear
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 4), 2 * 64 + 20);
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 5), -1);
+}
+
+TEST(BitScanTest, FreeRunSpansWords) {
+    std::vector<uint64_t> words(20, FULL);
+    words[10] = FULL >> 3;          // top 3 bits of word 10 clear
+    words[11] = 0;                  // whole word clear
+    words[12] = FULL << 2;          // low 2 bits of word 12 clear
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 69), 10 * 64 + 61);
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 70), -1);
+}
+
+TEST(BitScanTest, FreeRunPicksEarliest) {
+    std::vector<uint64_t> words(2, 0);
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 1), 0);
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 128), 0);
+    EXPECT_EQ(findFreeRun(words.data(), words.size(), 129), -1);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include "../src/msgQueueBroadcast.h"
+
+TEST(BroadcastQueueTest, EverySubscriberSeesEveryMessage) {
+    BroadcastQueueFixAlloc<> q(3);
+    uint8_t msg[BLOCK_SIZE];
+    uint8_t out[BLOCK_SIZE];
+
+    for (int i = 0; i < 10; ++i) {
+        memset(msg, i, BLOCK_SIZE);
+        ASSERT_TRUE(q.publish(msg));
+    }
+    for (size_t s = 0; s < q.subscribers(); ++s) {
+        EXPECT_EQ(q.lag(s), 10u);
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(q.receive(s, out));
+            EXPECT_EQ(out[0], i);
+        }
+        EXPECT_FALSE(q.receive(s, out));
+    }
+}
+
+TEST(BroadcastQueueTest, SubscribersShareOneBlock) {
+    BroadcastQueueFixAlloc<> q(2);
+    uint8_t msg[BLOCK_SIZE] = {0x5A};
+    ASSERT_TRUE(q.publish(msg));
+
+    MemRange a = q.acquire(0);
+    MemRange b = q.acquire(1);
+    ASSERT_TRUE(a.lo);
+    EXPECT_EQ(a.lo, b.lo);
+    EXPECT_EQ(a.lo[0], 0x5A);
+    EXPECT_TRUE(q.release(a));
+    EXPECT_TRUE(q.release(b));
+    EXPECT_FALSE(q.release(b));
+}
+
+TEST(BroadcastQueueTest, BlockReturnsToPoolAfterLastRelease) {
+    BroadcastQueueFixAlloc<> q(2);
+    uint8_t msg[BLOCK_SIZE] = {0x11};
+    for (size_t i = 0; i < q.kCapacity; ++i) ASSERT_TRUE(q.publish(msg));
+
+    // Both cursors are past the first message, but subscriber 1 still holds it.
+    MemRange first0 = q.acquire(0);
+    MemRange first1 = q.acquire(1);
+    EXPECT_TRUE(q.release(first0));
+    EXPECT_FALSE(q.publish(msg));
+
+    EXPECT_TRUE(q.release(first1));
+    EXPECT_TRUE(q.publish(msg));
+}
+
+TEST(BroadcastQueueTest, DropPolicyRejectsWhenSlowSubscriberIsFull) {
+    BroadcastQueueFixAlloc<SlowSubscriberPolicy::Drop> q(2);
+    uint8_t msg[BLOCK_SIZE] = {0x22};
+    uint8_t out[BLOCK_SIZE];
+    for (size_t i = 0; i < q.kCapacity; ++i) {
+        ASSERT_TRUE(q.publish(msg));
+        ASSERT_TRUE(q.receive(0, out));
+    }
+    EXPECT_FALSE(q.publish(msg));
+    EXPECT_EQ(q.dropped(), 1u);
+
+    ASSERT_TRUE(q.receive(1, out));
+    EXPECT_TRUE(q.publish(msg));
+}
+
+TEST(BroadcastQueueTest, OverwriteOldestSkipsSlowSubscriber) {
+    BroadcastQueueFixAlloc<SlowSubscriberPolicy::OverwriteOldest> q(2);
+    uint8_t msg[BLOCK_SIZE];
+    uint8_t out[BLOCK_SIZE];
+    for (size_t i = 0; i <= q.kCapacity; ++i) {
+        memset(msg, static_cast<int>(i), BLOCK_SIZE);
+        ASSERT_TRUE(q.publish(msg));
+        ASSERT_TRUE(q.receive(0, out));
+    }
+    EXPECT_EQ(q.overwritten(), 1u);
+    EXPECT_EQ(q.lag(1), q.kCapacity);
+
+    ASSERT_TRUE(q.receive(1, out));
+    EXPECT_EQ(out[0], 1);
+}
+
+TEST(BroadcastQueueTest, OverwriteOldestKeepsMessageWhenPoolIsHeld) {
+    BroadcastQueueFixAlloc<SlowSubscriberPolicy::OverwriteOldest> q(2);
+    uint8_t msg[BLOCK_SIZE] = {0x55};
+    MemRange held[q.kCapacity];
+    for (size_t i = 0; i < q.kCapacity; ++i) {
+        ASSERT_TRUE(q.publish(msg));
+        held[i] = q.acquire(0);
+        ASSERT_TRUE(held[i].lo);
+    }
+
+    // Subscriber 0 still holds every block, so skipping subscriber 1 would
+    // free nothing: the publish fails and subscriber 1 keeps its message.
+    EXPECT_FALSE(q.publish(msg));
+    EXPECT_EQ(q.overwritten(), 0u);
+    EXPECT_EQ(q.dropped(), 1u);
+    EXPECT_EQ(q.lag(1), q.kCapacity);
+
+    // Once subscriber 0 lets go of the oldest block, eviction frees it.
+    ASSERT_TRUE(q.release(held[0]));
+    EXPECT_TRUE(q.publish(msg));
+    EXPECT_EQ(q.overwritten(), 1u);
+
+    for (size_t i = 1; i < q.kCapacity; ++i) ASSERT_TRUE(q.release(held[i]));
+}
+
+TEST(BroadcastQueueTest, UnknownSubscriberReadsAsCaughtUp) {
+    BroadcastQueueFixAlloc<> q(2);
+    uint8_t msg[BLOCK_SIZE] = {0x66};
+    uint8_t out[BLOCK_SIZE];
+    ASSERT_TRUE(q.publish(msg));
+
+    EXPECT_FALSE(q.acquire(2).lo);
+    EXPECT_FALSE(q.receive(7, out));
+    EXPECT_EQ(q.lag(2), 0u);
+    EXPECT_EQ(q.lag(0), 1u);
+}
+
+TEST(BroadcastQueueTest, BlockPolicyWaitsForSlowSubscriber) {
+    BroadcastQueueFixAlloc<SlowSubscriberPolicy::Block> q(1);
+    uint8_t msg[BLOCK_SIZE] = {0x33};
+    uint8_t out[BLOCK_SIZE];
+    for (size_t i = 0; i < q.kCapacity; ++i) ASSERT_TRUE(q.publish(msg));
+
+    std::atomic<bool> published{false};
+    std::thread producer([&]() {
+        published.store(q.publish(msg));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(published.load());
+    ASSERT_TRUE(q.receive(0, out));
+    producer.join();
+    EXPECT_TRUE(published.load());
+    EXPECT_EQ(q.lag(0), q.kCapacity);
+}
+
+TEST(BroadcastQueueTest, NoSubscribersNeverExhaustsPool) {
+    BroadcastQueueFixAlloc<SlowSubscriberPolicy::Block> q(0);
+    uint8_t msg[BLOCK_SIZE] = {0x44};
+    for (size_t i = 0; i < 4 * q.kCapacity; ++i) ASSERT_TRUE(q.publish(msg));
+    EXPECT_EQ(q.dropped(), 0u);
+}
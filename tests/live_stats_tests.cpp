@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../src/liveStats.h"
+
+TEST(LiveStatsTest, BucketsAreLog2) {
+    EXPECT_EQ(liveBucket(0), 0u);
+    EXPECT_EQ(liveBucket(1), 1u);
+    EXPECT_EQ(liveBucket(255), 8u);
+    EXPECT_EQ(liveBucket(256), 9u);
+    EXPECT_EQ(liveBucket(1L << 50), static_cast<size_t>(LIVE_HIST_BUCKETS - 1));
+    EXPECT_GE(liveBucketUpperBound(liveBucket(1000)), 1000);
+}
+
+TEST(LiveStatsTest, PercentileFromHistogram) {
+    std::vector<uint64_t> counts(LIVE_HIST_BUCKETS, 0);
+    EXPECT_EQ(histogramPercentile(counts, 0.5), 0);
+
+    counts[liveBucket(100)] = 98;
+    counts[liveBucket(10000)] = 2;
+    EXPECT_EQ(histogramPercentile(counts, 0.50), liveBucketUpperBound(liveBucket(100)));
+    EXPECT_EQ(histogramPercentile(counts, 0.99), liveBucketUpperBound(liveBucket(10000)));
+}
+
+TEST(LiveStatsTest, ReporterWritesIntervalRows) {
+    std::ostringstream out;
+    LiveReporter reporter(2, std::chrono::milliseconds(10), out);
+    reporter.setPoolProbe([]() { return size_t(7); });
+    reporter.start();
+
+    for (int i = 0; i < 100; ++i) {
+        reporter.counters(0).record_enqueue(100, i % 10 != 0);
+        reporter.counters(1).record_dequeue(200, true);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    reporter.stop();
+
+    std::string text = out.str();
+    size_t rows = 0;
+    for (char ch : text) rows += ch == '\n';
+    EXPECT_GE(rows, 3u);  // header + at least two interval rows
+    EXPECT_EQ(text.rfind("t_ms,", 0), 0u);
+    EXPECT_NE(text.find(",7,"), std::string::npos);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "../src/msgQueuePriority.h"
+
+using TwoLaneQueue = PriorityMessageQueueFixAlloc<2>;
+
+TEST(PriorityQueueTest, UrgentLaneOvertakesBulk) {
+    TwoLaneQueue q;
+    uint8_t bulk[BLOCK_SIZE] = {0x0B};
+    uint8_t urgent[BLOCK_SIZE] = {0x0A};
+    uint8_t out[BLOCK_SIZE];
+    size_t lane = 99;
+
+    ASSERT_TRUE(q.enqueue(1, bulk));
+    ASSERT_TRUE(q.enqueue(1, bulk));
+    ASSERT_TRUE(q.enqueue(0, urgent));
+
+    ASSERT_TRUE(q.dequeue(out, &lane));
+    EXPECT_EQ(lane, 0u);
+    EXPECT_EQ(out[0], 0x0A);
+    ASSERT_TRUE(q.dequeue(out, &lane));
+    EXPECT_EQ(lane, 1u);
+    EXPECT_EQ(out[0], 0x0B);
+}
+
+TEST(PriorityQueueTest, FIFOWithinLane) {
+    TwoLaneQueue q;
+    uint8_t msg[BLOCK_SIZE];
+    uint8_t out[BLOCK_SIZE];
+    for (int i = 0; i < 5; ++i) {
+        memset(msg, i, BLOCK_SIZE);
+        ASSERT_TRUE(q.enqueue(1, msg));
+    }
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(q.dequeue(out));
+        EXPECT_EQ(out[0], i);
+    }
+    EXPECT_FALSE(q.dequeue(out));
+}
+
+TEST(PriorityQueueTest, LanesShareOnePool) {
+    TwoLaneQueue q;
+    uint8_t msg[BLOCK_SIZE] = {0x33};
+    for (int i = 0; i < NUM_BLOCKS; ++i) ASSERT_TRUE(q.enqueue(i % 2, msg));
+    EXPECT_FALSE(q.enqueue(0, msg));
+    EXPECT_EQ(q.size(), static_cast<size_t>(NUM_BLOCKS));
+    EXPECT_EQ(q.size(0), static_cast<size_t>(NUM_BLOCKS / 2));
+}
+
+TEST(PriorityQueueTest, OutOfRangeLaneIsRejected) {
+    TwoLaneQueue q;
+    uint8_t msg[BLOCK_SIZE] = {0x55};
+    uint8_t out[BLOCK_SIZE];
+
+    EXPECT_FALSE(q.enqueue(2, msg));
+    EXPECT_FALSE(q.enqueue(32, msg));
+    q.setLaneQuota(2, 0);
+    EXPECT_EQ(q.size(2), 0u);
+    EXPECT_EQ(q.size(), 0u);
+    EXPECT_FALSE(q.dequeue(out));
+
+    ASSERT_TRUE(q.enqueue(1, msg));
+    EXPECT_EQ(q.size(), 1u);
+}
+
+TEST(PriorityQueueTest, QuotaKeepsBlocksForUrgentLane) {
+    TwoLaneQueue q;
+    q.setLaneQuota(1, NUM_BLOCKS - 8);
+    uint8_t msg[BLOCK_SIZE] = {0x44};
+
+    int bulkAccepted = 0;
+    for (int i = 0; i < NUM_BLOCKS; ++i) bulkAccepted += q.enqueue(1, msg);
+    EXPECT_EQ(bulkAccepted, NUM_BLOCKS - 8);
+
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.enqueue(0, msg));
+    EXPECT_FALSE(q.enqueue(0, msg));
+}
+
+TEST(PriorityQueueTest, ReportsQueuedTime) {
+    TwoLaneQueue q;
+    uint8_t msg[BLOCK_SIZE] = {0x55};
+    uint8_t out[BLOCK_SIZE];
+    long queued = -1;
+    ASSERT_TRUE(q.enqueue(0, msg));
+    ASSERT_TRUE(q.dequeue(out, nullptr, &queued));
+    EXPECT_GE(queued, 0);
+}
@@ -106,3 +106,19 @@ TEST(MessageQueueFixAllocTest, ExhaustionRecovery) {
     ASSERT_TRUE(q.dequeue(out));
     ASSERT_TRUE(q.enqueue(msg)); 
 }
+
+TEST(MessageQueueStackAllocTest, FIFOAndExhaustion) {
+    MessageQueueStackAlloc q;
+    uint8_t msg[BLOCK_SIZE];
+    uint8_t out[BLOCK_SIZE];
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        memset(msg, i, BLOCK_SIZE);
+        ASSERT_TRUE(q.enqueue(msg));
+    }
+    EXPECT_FALSE(q.enqueue(msg));
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        ASSERT_TRUE(q.dequeue(out));
+        EXPECT_EQ(out[0], i);
+    }
+    EXPECT_EQ(q.size(), 0);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include "../src/msgQueueFixAlloc.h"
+#include "../src/shardedQueue.h"
+
+using TwoShardGroup = ShardedQueueGroup<MessageQueueFixAlloc, 2>;
+
+TEST(ShardedQueueTest, EnqueueTargetsRequestedShard) {
+    TwoShardGroup g;
+    uint8_t msg[BLOCK_SIZE] = {0x01};
+    ASSERT_TRUE(g.enqueue(1, msg));
+    EXPECT_EQ(g.depth(0), 0u);
+    EXPECT_EQ(g.depth(1), 1u);
+    EXPECT_EQ(g.size(), 1u);
+}
+
+TEST(ShardedQueueTest, SpillsToNextShardWhenFull) {
+    TwoShardGroup g;
+    uint8_t msg[BLOCK_SIZE] = {0x02};
+    for (int i = 0; i < QUEUE_MAX_SIZE; ++i) ASSERT_TRUE(g.enqueue(0, msg));
+    EXPECT_EQ(g.depth(0), static_cast<size_t>(QUEUE_MAX_SIZE));
+    EXPECT_EQ(g.depth(1), 0u);
+
+    ASSERT_TRUE(g.enqueue(0, msg));
+    EXPECT_EQ(g.depth(1), 1u);
+
+    for (int i = 1; i < QUEUE_MAX_SIZE; ++i) ASSERT_TRUE(g.enqueue(0, msg));
+    EXPECT_FALSE(g.enqueue(0, msg));
+    EXPECT_FALSE(g.enqueue(1, msg));
+    EXPECT_EQ(g.size(), static_cast<size_t>(2 * QUEUE_MAX_SIZE));
+}
+
+TEST(ShardedQueueTest, DrainsHomeBeforeStealing) {
+    TwoShardGroup g;
+    uint8_t fromZero[BLOCK_SIZE] = {0x0A};
+    uint8_t fromOne[BLOCK_SIZE] = {0x0B};
+    uint8_t out[BLOCK_SIZE];
+    ASSERT_TRUE(g.enqueue(0, fromZero));
+    ASSERT_TRUE(g.enqueue(1, fromOne));
+
+    ASSERT_TRUE(g.dequeue(1, out));
+    EXPECT_EQ(out[0], 0x0B);
+    EXPECT_EQ(g.steals(0), 0u);
+    EXPECT_EQ(g.steals(1), 0u);
+
+    ASSERT_TRUE(g.dequeue(1, out));
+    EXPECT_EQ(out[0], 0x0A);
+    EXPECT_EQ(g.steals(0), 1u);
+    EXPECT_EQ(g.steals(1), 0u);
+}
+
+TEST(ShardedQueueTest, StealsChargedToVictimShard) {
+    ShardedQueueGroup<MessageQueueFixAlloc, 4> g;
+    uint8_t msg[BLOCK_SIZE] = {0x03};
+    uint8_t out[BLOCK_SIZE];
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(g.enqueue(2, msg));
+
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(g.dequeue(0, out));
+    EXPECT_EQ(g.steals(2), 3u);
+    EXPECT_EQ(g.steals(0) + g.steals(1) + g.steals(3), 0u);
+    EXPECT_EQ(g.depth(2), 0u);
+}
+
+TEST(ShardedQueueTest, EmptyGroupDequeueFails) {
+    TwoShardGroup g;
+    uint8_t out[BLOCK_SIZE];
+    EXPECT_FALSE(g.dequeue(0, out));
+    EXPECT_FALSE(g.dequeue(1, out));
+    EXPECT_EQ(g.size(), 0u);
+}
+
+TEST(ShardedQueueTest, OutOfRangeShardWraps) {
+    TwoShardGroup g;
+    uint8_t msg[BLOCK_SIZE] = {0x04};
+    uint8_t out[BLOCK_SIZE];
+    ASSERT_TRUE(g.enqueue(3, msg));
+    EXPECT_EQ(g.depth(1), 1u);
+    EXPECT_EQ(g.depth(2), 0u);
+    EXPECT_EQ(g.steals(2), 0u);
+
+    ASSERT_TRUE(g.dequeue(5, out));
+    EXPECT_EQ(g.steals(1), 0u);
+}
+
+// The only test using three shards, so it sees the first consumer homes.
+TEST(ShardedQueueTest, ConsumerHomesIgnoreProducerThreads) {
+    using ThreeShardGroup = ShardedQueueGroup<MessageQueueFixAlloc, 3>;
+    uint8_t msg[BLOCK_SIZE] = {0};
+
+    // A producer thread starting first must not shift consumer homes.
+    {
+        ThreeShardGroup warmup;
+        std::thread([&] { EXPECT_TRUE(warmup.enqueue(msg)); }).join();
+    }
+
+    ThreeShardGroup g;
+    for (uint8_t s = 0; s < 3; ++s) {
+        memset(msg, s, BLOCK_SIZE);
+        ASSERT_TRUE(g.enqueue(s, msg));
+    }
+
+    uint8_t got[3] = {0xFF, 0xFF, 0xFF};
+    for (int k = 0; k < 3; ++k) {
+        std::thread([&] {
+            uint8_t out[BLOCK_SIZE];
+            EXPECT_TRUE(g.dequeue(out));
+            got[k] = out[0];
+        }).join();
+    }
+    EXPECT_EQ(got[0], 0);
+    EXPECT_EQ(got[1], 1);
+    EXPECT_EQ(got[2], 2);
+    for (size_t s = 0; s < 3; ++s) EXPECT_EQ(g.steals(s), 0u);
+}